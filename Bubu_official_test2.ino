@@ -16,7 +16,7 @@ void setup() {
   MotionEngine::setDebug(true);
 }
 void loop() {
-  // If a motion animation just played, skip one engine cycle (it will redraw idle next loop)
+  // While a motion animation plays it draws the frame; otherwise the engine does
   bool played = MotionEngine::update();
   if (!played) {
     bubuEngineLoop();                // idle/random emotions + recentering
@@ -0,0 +1,717 @@
+#include "bubu_canvas.h"
+
+BubuCanvas::BubuCanvas(uint16_t w, uint16_t h) : GFXcanvas16(w, h) {
+  pix = buffer;
+  setRound(false);
+  clearRows(cur0, cur1, curTop, curBottom);
+  clearRows(prev0, prev1, prevTop, prevBottom);
+  markAllDirty();
+}
+
+void BubuCanvas::clearRows(uint8_t *r0, uint8_t *r1, int &top, int &bottom) {
+  memset(r0, 0xFF, MAX_ROWS);
+  memset(r1, 0x00, MAX_ROWS);
+  top = MAX_ROWS;
+  bottom = 0;
+}
+
+// ================= GFX overrides =================
+
+void BubuCanvas::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((uint16_t)y >= (uint16_t)_height) return;
+  if (x < span0[y] || x >= span1[y]) return;
+  if (recording()) recordRect(x, y, 1, 1, color);
+  fillSpan(y, x, x + 1, color);
+}
+
+void BubuCanvas::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void BubuCanvas::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+void BubuCanvas::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (w < 0) { x += w + 1; w = -w; }
+  if (h < 0) { y += h + 1; h = -h; }
+  int x0 = x, y0 = y, x1 = x + w, y1 = y + h;
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 > _width)  x1 = _width;
+  if (y1 > _height) y1 = _height;
+  if (replaying) {
+    if (y0 < bandY0) y0 = bandY0;
+    if (y1 > bandY1) y1 = bandY1;
+  }
+  if (x0 >= x1 || y0 >= y1) return;
+  if (recording()) recordRect(x0, y0, x1 - x0, y1 - y0, color);
+  if (half) {                              // odd rows are never sampled
+    for (int yy = (y0 + 1) & ~1; yy < y1; yy += 2) fillSpan(yy, x0, x1, color);
+    return;
+  }
+  for (int yy = y0; yy < y1; ++yy) fillSpan(yy, x0, x1, color);
+}
+
+void BubuCanvas::fillScreen(uint16_t color) {
+  if (banded) {
+    // everything recorded so far is covered: start the list over
+    opCount = 0;
+    refCount = 0;
+    listCleared = true;
+    recordRect(0, 0, _width, _height, color);
+  } else if (half) {
+    for (int y = 0; y < _height; y += 2) halfSpan(y, span0[y], span1[y], color);
+  } else {
+    const uint16_t raw = toRaw(color);
+    for (int y = 0; y < _height; ++y) {
+      uint16_t *p = buffer + y * WIDTH + span0[y];
+      for (int n = span1[y] - span0[y]; n > 0; --n) *p++ = raw;
+    }
+  }
+  if (!(bgValid && color == bgColor)) {
+    markAllDirty();
+    bgColor = color;
+    bgValid = true;
+  }
+  clearedThisFrame = true;
+}
+
+static inline int clampRow(int y, int h) { return y < 0 ? 0 : (y > h ? h : y); }
+
+void BubuCanvas::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  if (recording()) {
+    if (Op *op = addOp(OP_CIRCLE, y0 - r, y0 + r + 1, color)) {
+      op->v[0] = x0; op->v[1] = y0; op->v[2] = r;
+    }
+  }
+  ++nest;                                  // decompose for damage (or pixels)
+  Adafruit_GFX::fillCircle(x0, y0, r, color);
+  --nest;
+}
+
+void BubuCanvas::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                               int16_t r, uint16_t color) {
+  if (recording()) {
+    if (Op *op = addOp(OP_ROUNDRECT, y, y + h, color)) {
+      op->v[0] = x; op->v[1] = y; op->v[2] = w; op->v[3] = h; op->v[4] = r;
+    }
+  }
+  roundRectRows(x, y, w, h, r, color);
+}
+
+void BubuCanvas::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                              int16_t x2, int16_t y2, uint16_t color) {
+  if (recording()) {
+    const int top = min(y0, min(y1, y2)), bottom = max(y0, max(y1, y2)) + 1;
+    if (Op *op = addOp(OP_TRIANGLE, top, bottom, color)) {
+      op->v[0] = x0; op->v[1] = y0; op->v[2] = x1;
+      op->v[3] = y1; op->v[4] = x2; op->v[5] = y2;
+    }
+  }
+  ++nest;
+  Adafruit_GFX::fillTriangle(x0, y0, x1, y1, x2, y2, color);
+  --nest;
+}
+
+// ================= Display list =================
+
+BubuCanvas::Op *BubuCanvas::addOp(uint8_t kind, int top, int bottom, uint16_t color) {
+  top = clampRow(top, _height);
+  bottom = clampRow(bottom, _height);
+  if (top >= bottom) return nullptr;       // entirely off-screen
+  if (opCount == LIST_CAPACITY) {
+    spill();
+    return nullptr;
+  }
+  Op *op = &ops[opCount++];
+  op->kind = kind;
+  op->top = (uint8_t)top;
+  op->bottom = (uint8_t)bottom;
+  op->color = color;
+  return op;
+}
+
+// List full: spill to the full buffer and finish the frame direct. If that
+// buffer cannot be had, the op is lost; the frame is flagged (listDropped())
+// and no further spill is tried until it ends.
+void BubuCanvas::spill() {
+  overflowed = true;
+  if (!dropped && setRaster(Raster::FULL)) return;
+  dropped = true;
+}
+
+// Rects arrive already clipped. Pixels and 1-row rects continuing the
+// previous run (lines, glyphs) are merged into it.
+void BubuCanvas::recordRect(int x, int y, int w, int h, uint16_t color) {
+  if (h == 1 && opCount > 0) {
+    Op &last = ops[opCount - 1];
+    if (last.kind == OP_RECT && last.color == color && last.v[1] == y &&
+        last.v[3] == 1 && last.v[0] + last.v[2] == x) {
+      last.v[2] += w;
+      return;
+    }
+  }
+  if (Op *op = addOp(OP_RECT, y, y + h, color)) {
+    op->v[0] = x; op->v[1] = y; op->v[2] = w; op->v[3] = h;
+  }
+}
+
+// Replays every op that reaches rows [y0, y1) into pix; fillSpan() clips
+// rows to the window.
+void BubuCanvas::replay(int y0, int y1) {
+  bandY0 = y0;
+  bandY1 = y1;
+  if (!listCleared) {
+    const size_t px = half ? (size_t)(WIDTH / 2) * (HEIGHT / 2) : (size_t)(y1 - y0) * WIDTH;
+    memset(pix, 0, px * 2);
+  }
+  replaying = true;
+  ++nest;
+  for (int i = 0; i < opCount; ++i) {
+    const Op &op = ops[i];
+    if (op.bottom <= y0 || op.top >= y1) continue;
+    const int16_t *v = op.v;
+    switch (op.kind) {
+      case OP_RECT:      fillRect(v[0], v[1], v[2], v[3], op.color); break;
+      case OP_CIRCLE:    Adafruit_GFX::fillCircle(v[0], v[1], v[2], op.color); break;
+      case OP_ROUNDRECT: roundRectRows(v[0], v[1], v[2], v[3], v[4], op.color); break;
+      case OP_TRIANGLE:  Adafruit_GFX::fillTriangle(v[0], v[1], v[2], v[3], v[4], v[5], op.color); break;
+      case OP_RADIAL:    radialRows(v[0], v[1], v[2], (const uint16_t *)refs[v[3]]); break;
+      case OP_SPRITES:   spriteRows((const SpriteMask *)refs[v[0]], (const Sprite *)refs[v[0] + 1], v[1]); break;
+      case OP_ANNULUS:   annulusRows(v[0], v[1], v[2], v[3], op.color); break;
+    }
+  }
+  --nest;
+  replaying = false;
+}
+
+void BubuCanvas::rasterBand(int y0, int y1) {
+  if (banded) replay(y0, y1);
+}
+
+bool BubuCanvas::setRaster(Raster r) {
+  if (r == mode) return true;
+  const int hw = WIDTH / 2, hh = HEIGHT / 2;
+
+  // 1) storage for the new mode. FULL/HALF start zeroed: a replay over a
+  // cleared list skips its memset, and pixels no op covers (the corners
+  // outside the round spans) can still reach the panel.
+  uint16_t *store = nullptr;
+  if (r == Raster::BANDED) {
+    if (!band) band = (uint16_t *)malloc((size_t)WIDTH * BAND_ROWS * 2);
+    if (!ops)  ops  = (Op *)malloc(sizeof(Op) * LIST_CAPACITY);
+    if (!band || !ops) return false;
+    store = band;
+  } else if (r == Raster::FULL) {
+    store = (uint16_t *)calloc((size_t)WIDTH * HEIGHT, 2);
+  } else {
+    if (!line) line = (uint16_t *)malloc((size_t)WIDTH * 2);
+    store = line ? (uint16_t *)calloc((size_t)hw * hh, 2) : nullptr;
+  }
+  if (!store) return false;
+
+  // 2) carry the picture over
+  if (mode == Raster::BANDED) {
+    pix = store;
+    half = (r == Raster::HALF);
+    replay(0, _height);
+  } else if (mode == Raster::FULL && r == Raster::HALF) {
+    for (int y = 0; y < hh; ++y)
+      for (int x = 0; x < hw; ++x) store[y * hw + x] = pix[(2 * y) * WIDTH + 2 * x];
+  } else if (mode == Raster::HALF && r == Raster::FULL) {
+    for (int y = 0; y < HEIGHT; ++y)
+      for (int x = 0; x < WIDTH; ++x) store[y * WIDTH + x] = pix[(y >> 1) * hw + (x >> 1)];
+  }
+
+  // 3) release the old store
+  if (mode == Raster::BANDED) {
+    free(band); band = nullptr;
+    free(ops);  ops = nullptr;
+  } else {
+    free(pix);
+  }
+
+  buffer = (r == Raster::FULL) ? store : nullptr;
+  pix = store;
+  banded = (r == Raster::BANDED);
+  half = (r == Raster::HALF);
+  bandY0 = 0;
+  bandY1 = _height;
+  opCount = 0;
+  refCount = 0;
+  listCleared = false;
+  if (mode == Raster::HALF || r == Raster::HALF) markAllDirty();   // resampled
+  mode = r;
+  return true;
+}
+
+// ================= Half resolution =================
+
+// Samples the even pixels of a span: (x, y) lands in store[(y/2, x/2)] when
+// both are even. Damage covers the 2x2 blocks that changed.
+void BubuCanvas::halfSpan(int y, int x0, int x1, uint16_t color) {
+  if (y & 1) return;
+  const int hx0 = (x0 + 1) >> 1, hx1 = (x1 + 1) >> 1;
+  if (hx0 >= hx1) return;
+  if (!replaying) {
+    const int dx1 = (2 * hx1 < _width) ? 2 * hx1 : _width;
+    touchRow(y, 2 * hx0, dx1);
+    touchRow(y + 1, 2 * hx0, dx1);
+  }
+  const uint16_t raw = toRaw(color);
+  uint16_t *p = pix + (y >> 1) * (WIDTH / 2) + hx0;
+  for (int n = hx1 - hx0; n > 0; --n) *p++ = raw;
+}
+
+const uint16_t *BubuCanvas::expandRow(int y) {
+  const uint16_t *s = pix + (y >> 1) * (WIDTH / 2);
+  uint16_t *d = line;
+  for (int n = WIDTH / 2; n > 0; --n, d += 2) d[0] = d[1] = *s++;
+  return line;
+}
+
+// ================= Direct pixel access =================
+
+// Stored pixels of the visible part of row y, [x0, x1): returns the count
+// (0 if none) and points p at the first one. Marks the span dirty.
+int BubuCanvas::lockSpan(int y, int x0, int x1, uint16_t *&p) {
+  if (banded || (uint16_t)y >= (uint16_t)_height) return 0;
+  if (x0 < span0[y]) x0 = span0[y];
+  if (x1 > span1[y]) x1 = span1[y];
+  if (x0 >= x1) return 0;
+  if (half) {
+    if (y & 1) return 0;
+    const int hx0 = (x0 + 1) >> 1, hx1 = (x1 + 1) >> 1;
+    if (hx0 >= hx1) return 0;
+    const int dx1 = (2 * hx1 < _width) ? 2 * hx1 : _width;
+    touchRow(y, 2 * hx0, dx1);
+    touchRow(y + 1, 2 * hx0, dx1);
+    p = pix + (y >> 1) * (WIDTH / 2) + hx0;
+    return hx1 - hx0;
+  }
+  touchRow(y, x0, x1);
+  p = pix + y * WIDTH + x0;
+  return x1 - x0;
+}
+
+// Two pixels per word, each channel in its own 16-bit lane so one
+// multiply scales the pair. Raw byte order only matters for non-zero words.
+static inline uint32_t dimPair(uint32_t w, uint32_t k, bool swapped) {
+  if (swapped) w = ((w >> 8) & 0x00FF00FFu) | ((w & 0x00FF00FFu) << 8);
+  const uint32_t r = (((w >> 11) & 0x001F001Fu) * k >> 8) & 0x001F001Fu;
+  const uint32_t g = (((w >> 5)  & 0x003F003Fu) * k >> 8) & 0x003F003Fu;
+  const uint32_t b = (( w        & 0x001F001Fu) * k >> 8) & 0x001F001Fu;
+  w = (r << 11) | (g << 5) | b;
+  if (swapped) w = ((w >> 8) & 0x00FF00FFu) | ((w & 0x00FF00FFu) << 8);
+  return w;
+}
+
+void BubuCanvas::dim(uint8_t f) {
+  if (banded || f == 255) return;
+  const uint32_t k = f + 1u;
+  const int step = half ? 2 : 1, stride = half ? WIDTH / 2 : WIDTH;
+  for (int y = 0; y < _height; y += step) {
+    uint16_t *row = pix + (y / step) * stride;
+    int x0 = half ? (span0[y] + 1) >> 1 : span0[y];
+    int x1 = half ? (span1[y] + 1) >> 1 : span1[y];
+    if (x0 >= x1) continue;
+    // rows start word-aligned (even stride), so pair from an even x
+    if (x0 & 1) { if (row[x0]) row[x0] = toRaw(dim565(fromRaw(row[x0]), f)); ++x0; }
+    if (x1 & 1) { --x1; if (row[x1]) row[x1] = toRaw(dim565(fromRaw(row[x1]), f)); }
+    uint32_t *w = (uint32_t *)(row + x0), *end = (uint32_t *)(row + x1);
+    while (w < end) {
+      while (w < end && *w == 0) ++w;               // black run
+      for (; w < end && *w; ++w) *w = dimPair(*w, k, swapped);
+    }
+  }
+  markAllDirty();
+}
+
+// ================= Pixel order =================
+
+// Existing pixels are converted, so switching mid-animation is seamless.
+// (A banded list holds host-order colours and needs nothing.)
+void BubuCanvas::setPixelOrder(PixelOrder order) {
+  const bool on = (order == PixelOrder::PANEL);
+  if (on == swapped) return;
+  swapped = on;
+  if (!banded) {
+    const int n = half ? (WIDTH / 2) * (HEIGHT / 2) : WIDTH * HEIGHT;
+    for (int i = 0; i < n; ++i) {
+      const uint16_t v = pix[i];
+      pix[i] = (uint16_t)((v >> 8) | (v << 8));
+    }
+  }
+}
+
+// ================= Round panel =================
+
+// Pixel (x, y) is visible when its centre lies inside the panel circle.
+void BubuCanvas::setRound(bool on) {
+  round = on;
+  const float r = WIDTH * 0.5f, cx = WIDTH * 0.5f, cy = HEIGHT * 0.5f;
+  for (int y = 0; y < HEIGHT; ++y) {
+    int x0 = 0, x1 = WIDTH;
+    if (on) {
+      const float dy = (y + 0.5f) - cy;
+      const float d  = r * r - dy * dy;
+      const float hw = (d > 0.0f) ? sqrtf(d) : 0.0f;
+      x0 = (int)ceilf(cx - hw - 0.5f);
+      x1 = (int)floorf(cx + hw - 0.5f) + 1;
+      if (x0 < 0) x0 = 0;
+      if (x1 > WIDTH) x1 = WIDTH;
+      if (x1 < x0) x1 = x0;
+    }
+    span0[y] = (uint8_t)x0;
+    span1[y] = (uint8_t)x1;
+  }
+  markAllDirty();
+}
+
+// ================= Damage =================
+
+void BubuCanvas::markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+  int y0 = y, y1 = y + h;
+  if (y0 < 0) y0 = 0;
+  if (y1 > _height) y1 = _height;
+  for (int yy = y0; yy < y1; ++yy) {
+    const int x0 = (x > span0[yy]) ? x : span0[yy];
+    const int x1 = (x + w < span1[yy]) ? x + w : span1[yy];
+    if (x0 < x1) touchRow(yy, x0, x1);
+  }
+}
+
+void BubuCanvas::markAllDirty() {
+  memcpy(cur0, span0, _height);
+  memcpy(cur1, span1, _height);
+  curTop = 0;
+  curBottom = _height;
+  bgValid = false;   // someone changed pixels we cannot account for
+}
+
+bool BubuCanvas::dirtyRow(int y, int16_t &x0, int16_t &x1) const {
+  int a = cur0[y] < prev0[y] ? cur0[y] : prev0[y];
+  int b = cur1[y] > prev1[y] ? cur1[y] : prev1[y];
+  if (a >= b) return false;
+  x0 = a; x1 = b;
+  return true;
+}
+
+void BubuCanvas::endFrame() {
+  memcpy(prev0, cur0, MAX_ROWS);
+  memcpy(prev1, cur1, MAX_ROWS);
+  prevTop = curTop;
+  prevBottom = curBottom;
+  clearRows(cur0, cur1, curTop, curBottom);
+  // A frame that drew on top of the old one keeps stale content outside
+  // the tracked rows, so the next clear has to be pushed in full.
+  if (!clearedThisFrame) bgValid = false;
+  clearedThisFrame = false;
+  overflowed = false;
+  dropped = false;
+}
+
+void BubuCanvas::carryFrame() {
+  for (int y = 0; y < MAX_ROWS; ++y) {
+    if (cur0[y] < prev0[y]) prev0[y] = cur0[y];
+    if (cur1[y] > prev1[y]) prev1[y] = cur1[y];
+  }
+  if (curTop < prevTop)       prevTop = curTop;
+  if (curBottom > prevBottom) prevBottom = curBottom;
+  clearRows(cur0, cur1, curTop, curBottom);
+  if (!clearedThisFrame) bgValid = false;
+  clearedThisFrame = false;
+  overflowed = false;
+  dropped = false;
+}
+
+// ================= Round rects =================
+
+// Corner rows for radius r, cached LRU. Built by running the same midpoint
+// walk as Adafruit_GFX::fillCircleHelper and recording where each corner
+// column starts, so the stamped shape matches fillRoundRect exactly.
+const uint8_t *BubuCanvas::cornerInsets(int r) {
+  Corner *slot = &corners[0];
+  for (Corner &c : corners) {
+    if (c.r == r) { c.used = ++cornerClock; return c.inset; }
+    if ((uint16_t)(cornerClock - c.used) > (uint16_t)(cornerClock - slot->used)) slot = &c;
+  }
+  uint8_t top[CORNER_MAX_R + 1];          // first row (from the top) of column r - c
+  memset(top, r, sizeof(top));
+  top[0] = 0;
+  int f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, yy = r, px = 0, py = r;
+  while (x < yy) {
+    if (f >= 0) { yy--; ddF_y += 2; f += ddF_y; }
+    x++; ddF_x += 2; f += ddF_x;
+    if (x < yy + 1 && r - yy < top[x]) top[x] = r - yy;
+    if (yy != py) {
+      if (r - px < top[py]) top[py] = r - px;
+      py = yy;
+    }
+    px = x;
+  }
+  // row k keeps every column c with top[c] <= k; the shape is convex
+  int c = 0;
+  for (int k = 0; k < r; ++k) {
+    while (c < r && top[c + 1] <= k) ++c;
+    slot->inset[k] = (uint8_t)(r - c);
+  }
+  slot->r = (int16_t)r;
+  slot->used = ++cornerClock;
+  return slot->inset;
+}
+
+int BubuCanvas::roundRectInset(int w, int h, int r, int k) {
+  const int maxR = ((w < h) ? w : h) / 2;
+  if (r > maxR) r = maxR;
+  if (r > CORNER_MAX_R) r = CORNER_MAX_R;
+  const int e = (k < h - 1 - k) ? k : h - 1 - k;
+  return (r > 0 && e >= 0 && e < r) ? cornerInsets(r)[e] : 0;
+}
+
+void BubuCanvas::roundRectRows(int x, int y, int w, int h, int r, uint16_t color) {
+  const int maxR = ((w < h) ? w : h) / 2;
+  if (r > maxR) r = maxR;
+  if (w <= 0 || h <= 0) return;
+  if (r > CORNER_MAX_R) {
+    ++nest;
+    Adafruit_GFX::fillRoundRect(x, y, w, h, r, color);
+    --nest;
+    return;
+  }
+  const uint8_t *inset = r > 0 ? cornerInsets(r) : nullptr;
+  int k0 = y < 0 ? -y : 0, k1 = (y + h > _height) ? _height - y : h;
+  if (replaying) {
+    if (k0 < bandY0 - y) k0 = bandY0 - y;
+    if (k1 > bandY1 - y) k1 = bandY1 - y;
+  }
+  for (int k = k0; k < k1; ++k) {
+    const int yy = y + k;
+    if (half && (yy & 1)) continue;
+    const int e = (k < h - 1 - k) ? k : h - 1 - k;     // rows from the nearer edge
+    const int in = (e < r) ? inset[e] : 0;
+    int x0 = x + in, x1 = x + w - in;
+    if (x0 < 0) x0 = 0;
+    if (x1 > _width) x1 = _width;
+    if (x0 < x1) fillSpan(yy, x0, x1, color);
+  }
+}
+
+// ================= Annulus =================
+
+void BubuCanvas::fillAnnulus(int16_t x0, int16_t y0, int16_t rIn, int16_t rOut, uint16_t color) {
+  if (rOut < 0 || rIn >= rOut) return;
+  if (rIn < -1) rIn = -1;                  // -1: solid disc
+  if (recording()) {
+    if (Op *op = addOp(OP_ANNULUS, y0 - rOut, y0 + rOut + 1, color)) {
+      op->v[0] = x0; op->v[1] = y0; op->v[2] = rIn; op->v[3] = rOut;
+    }
+  }
+  annulusRows(x0, y0, rIn, rOut, color);
+}
+
+// Same per-row coverage as blendCircle(), minus the inner disc
+void BubuCanvas::annulusRows(int x0, int y0, int rIn, int rOut, uint16_t color) {
+  const int32_t ro2 = (int32_t)rOut * rOut, ri2 = (int32_t)rIn * rIn;
+  int wo = 0, wi = 0;
+  for (int dy = -rOut; dy <= rOut; ++dy) {
+    const int y = y0 + dy;
+    const int32_t dy2 = (int32_t)dy * dy;
+    while ((int32_t)(wo + 1) * (wo + 1) <= ro2 - dy2) ++wo;
+    while ((int32_t)wo * wo > ro2 - dy2) --wo;
+    if ((uint16_t)y >= (uint16_t)_height || (half && (y & 1))) continue;
+    if (rIn < 0 || dy2 > ri2) {            // above/below the hole: one span
+      fillSpan(y, x0 - wo, x0 + wo + 1, color);
+      continue;
+    }
+    while ((int32_t)(wi + 1) * (wi + 1) <= ri2 - dy2) ++wi;
+    while ((int32_t)wi * wi > ri2 - dy2) --wi;
+    fillSpan(y, x0 - wo, x0 - wi, color);
+    fillSpan(y, x0 + wi + 1, x0 + wo + 1, color);
+  }
+}
+
+// ================= Sprites =================
+
+void BubuCanvas::SpriteMask::add(int dy, int x0, int x1) {
+  if (x0 >= x1) return;
+  const bool first = (runs == 0);
+  SpriteRun *l = first ? nullptr : &run[runs - 1];
+  if (l && l->dy == dy && x0 <= l->x1 && x1 >= l->x0) {   // extend the previous run
+    if (x0 < l->x0) l->x0 = x0;
+    if (x1 > l->x1) l->x1 = x1;
+  } else if (runs < SPRITE_RUNS) {
+    run[runs++] = { (int8_t)dy, (int8_t)x0, (int8_t)x1 };
+  } else {
+    return;
+  }
+  if (first) { top = dy; bottom = dy + 1; left = x0; right = x1; return; }
+  if (dy < top) top = dy;
+  if (dy + 1 > bottom) bottom = dy + 1;
+  if (x0 < left) left = x0;
+  if (x1 > right) right = x1;
+}
+
+void BubuCanvas::stampBatch(const SpriteMask *masks, const Sprite *s, int n) {
+  if (n <= 0) return;
+  if (recording()) {
+    int top = _height, bottom = 0;
+    for (int i = 0; i < n; ++i) {
+      const SpriteMask &m = masks[s[i].mask];
+      if (s[i].y + m.top < top) top = s[i].y + m.top;
+      if (s[i].y + m.bottom > bottom) bottom = s[i].y + m.bottom;
+    }
+    const int ref = addRefs(masks, s);
+    if (ref >= 0) {
+      if (Op *op = addOp(OP_SPRITES, top, bottom, 0)) { op->v[0] = ref; op->v[1] = n; }
+    }
+  }
+  spriteRows(masks, s, n);
+}
+
+void BubuCanvas::spriteRows(const SpriteMask *masks, const Sprite *s, int n) {
+  const bool direct = !banded && !half;    // full buffer: whole sprites skip clipping
+  for (; n > 0; --n, ++s) {
+    const SpriteMask &m = masks[s->mask];
+    const int y0 = s->y + m.top, y1 = s->y + m.bottom;
+    const int x0 = s->x + m.left, x1 = s->x + m.right;
+    if (y1 <= 0 || y0 >= _height || x1 <= 0 || x0 >= _width) continue;
+    if (replaying && (y1 <= bandY0 || y0 >= bandY1)) continue;
+    if (direct && y0 >= 0 && y1 <= _height &&            // visible area is convex:
+        x0 >= span0[y0] && x1 <= span1[y0] &&            // corners inside => all inside
+        x0 >= span0[y1 - 1] && x1 <= span1[y1 - 1]) {
+      const uint16_t raw = toRaw(s->color);
+      for (int i = 0; i < m.runs; ++i) {
+        const SpriteRun &r = m.run[i];
+        const int y = s->y + r.dy, a = s->x + r.x0, b = s->x + r.x1;
+        touchRow(y, a, b);
+        uint16_t *p = pix + y * WIDTH + a;
+        for (int k = b - a; k > 0; --k) *p++ = raw;
+      }
+      continue;
+    }
+    for (int i = 0; i < m.runs; ++i) {
+      const SpriteRun &r = m.run[i];
+      const int y = s->y + r.dy;
+      if ((uint16_t)y < (uint16_t)_height) fillSpan(y, s->x + r.x0, s->x + r.x1, s->color);
+    }
+  }
+}
+
+// ================= Radial gradient =================
+
+void BubuCanvas::fillRadial(int16_t x0, int16_t y0, int16_t r, const uint16_t *lut) {
+  if (r < 0) return;
+  if (recording()) {
+    const int ref = addRefs(lut);
+    if (ref >= 0) {
+      if (Op *op = addOp(OP_RADIAL, y0 - r, y0 + r + 1, 0)) {
+        op->v[0] = x0; op->v[1] = y0; op->v[2] = r; op->v[3] = ref;
+      }
+    }
+  }
+  radialRows(x0, y0, r, lut);
+}
+
+// Slot(s) for tables an op points at; out of slots spills like a full list
+int BubuCanvas::addRefs(const void *a, const void *b) {
+  const int need = b ? 2 : 1;
+  if (refCount + need > REF_CAPACITY) {
+    spill();
+    return -1;
+  }
+  refs[refCount] = a;
+  if (b) refs[refCount + 1] = b;
+  refCount += need;
+  return refCount - need;
+}
+
+// Same coverage as blendCircle(): one span per row, half-width stepped
+void BubuCanvas::radialRows(int x0, int y0, int r, const uint16_t *lut) {
+  const int32_t rr = (int32_t)r * r;
+  int w = 0;
+  for (int dy = -r; dy <= r; ++dy) {
+    const int y = y0 + dy;
+    const int32_t d = rr - (int32_t)dy * dy;
+    while ((int32_t)(w + 1) * (w + 1) <= d) ++w;
+    while ((int32_t)w * w > d) --w;
+    if ((uint16_t)y < (uint16_t)_height) radialSpan(y, x0 - w, x0 + w + 1, x0, (int32_t)dy * dy, lut);
+  }
+}
+
+void BubuCanvas::radialSpan(int y, int x0, int x1, int cx, int32_t dy2, const uint16_t *lut) {
+  if (x0 < span0[y]) x0 = span0[y];
+  if (x1 > span1[y]) x1 = span1[y];
+  if (x0 >= x1) return;
+  if (replaying) {                          // no damage; half when leaving BANDED for HALF
+    if (y < bandY0 || y >= bandY1) return;
+    if (half) {
+      if (y & 1) return;
+      const int hx0 = (x0 + 1) >> 1, hx1 = (x1 + 1) >> 1;
+      uint16_t *p = pix + (y >> 1) * (WIDTH / 2) + hx0;
+      for (int x = 2 * hx0; x < 2 * hx1; x += 2) *p++ = toRaw(lut[(x - cx) * (x - cx) + dy2]);
+      return;
+    }
+    uint16_t *p = pix + (y - bandY0) * WIDTH + x0;
+    for (int x = x0; x < x1; ++x) *p++ = toRaw(lut[(x - cx) * (x - cx) + dy2]);
+    return;
+  }
+  if (banded) { touchRow(y, x0, x1); return; }
+  uint16_t *p;
+  int n = lockSpan(y, x0, x1, p);
+  const int step = half ? 2 : 1;
+  for (int x = half ? (x0 + 1) & ~1 : x0; n > 0; --n, x += step)
+    *p++ = toRaw(lut[(x - cx) * (x - cx) + dy2]);
+}
+
+// ================= Alpha blending =================
+
+// 565 spread so each channel has headroom for a 5-bit multiply:
+// 00000gggggg00000rrrrr000000bbbbb
+static inline uint32_t spread565(uint16_t c) { return (c | ((uint32_t)c << 16)) & 0x07E0F81Fu; }
+static inline uint16_t pack565(uint32_t v)   { v &= 0x07E0F81Fu; return (uint16_t)(v | (v >> 16)); }
+
+void BubuCanvas::blendSpan(int y, int x0, int x1, uint16_t color, uint8_t alpha) {
+  uint16_t *p;
+  int n = lockSpan(y, x0, x1, p);
+  if (n == 0) return;
+  const uint32_t a5 = (alpha + 4u) >> 3;   // 0..32
+  if (a5 == 0) return;
+  if (a5 == 32) {
+    const uint16_t raw = toRaw(color);
+    while (n--) *p++ = raw;
+    return;
+  }
+  if (a5 == 16) {                          // 50%: average, channel LSBs masked off
+    const uint16_t f = (color & 0xF7DE) >> 1;
+    for (; n > 0; --n, ++p) *p = toRaw(f + ((fromRaw(*p) & 0xF7DE) >> 1));
+    return;
+  }
+  if (a5 == 8) {                           // 25%: bg - bg/4 + fg/4
+    const uint16_t f = (color & 0xE79C) >> 2;
+    for (; n > 0; --n, ++p) {
+      const uint16_t b = fromRaw(*p);
+      *p = toRaw(b - ((b & 0xE79C) >> 2) + f);
+    }
+    return;
+  }
+  const uint32_t fg = spread565(color);
+  for (; n > 0; --n, ++p) {
+    const uint32_t bg = spread565(fromRaw(*p));
+    *p = toRaw(pack565(bg + (((fg - bg) * a5) >> 5)));
+  }
+}
+
+// Same coverage as testing dx*dx + dy*dy <= r*r per pixel, one span per row
+void BubuCanvas::blendCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color, uint8_t alpha) {
+  if (r < 0 || banded) return;
+  const int32_t rr = (int32_t)r * r;
+  int w = 0;
+  for (int dy = -r; dy <= r; ++dy) {
+    const int32_t d = rr - (int32_t)dy * dy;
+    while ((int32_t)(w + 1) * (w + 1) <= d) ++w;
+    while ((int32_t)w * w > d) --w;
+    blendSpan(y0 + dy, x0 - w, x0 + w + 1, color, alpha);
+  }
+}
@@ -0,0 +1,248 @@
+#pragma once
+#include <Adafruit_GFX.h>
+
+// Shared frame canvas (GFXcanvas16 + damage tracking).
+// Every GFX primitive ends up in drawPixel()/fillRect() here, which widen a
+// per-row [x0, x1) dirty interval. PresentEngine pushes only those rows, so a
+// frame where two eyes moved costs a fraction of the full 115 KB blit.
+// Rotation is assumed to be 0 (the engine never rotates the canvas).
+//
+// Round mode: the GC9A01A is a 240 px circle, so ~21% of the buffer is never
+// visible. With setRound(true) every fill, dim and present is clipped to the
+// per-row visible span [rowStart(y), rowEnd(y)).
+//
+// Banded mode: the 115 KB buffer is released. Drawing records a display list
+// (one op per rect/circle/round-rect/triangle, pixels merged into runs) and
+// PresentEngine replays it into a 240 x BAND_ROWS strip, one band at a time,
+// streaming each band while the next one rasterizes. Damage is still tracked
+// while recording. A frame that overflows the list spills: the full buffer is
+// allocated, the list replayed into it, and drawing continues direct (if
+// that allocation fails, the overflowing ops are dropped and flagged).
+// Read-back is not available while banded: getBuffer() returns nullptr and
+// getPixel() returns 0.
+//
+// Half mode: drawing keeps 240x240 coordinates but only even pixels are
+// sampled into a 120x120 store (28.8 KB), so fills and per-pixel effects do a
+// quarter of the work. rowPtr() pixel-doubles rows for present. Direct
+// access goes through dim()/blendSpan(); getBuffer() returns nullptr.
+//
+// Pixel order: PANEL stores every pixel byte-swapped (big-endian RGB565, the
+// GC9A01A wire format), so present is a plain copy. Colours passed in and
+// getPixel() stay host-order either way; only code touching getBuffer()
+// directly has to go through toRaw()/fromRaw().
+class BubuCanvas : public GFXcanvas16 {
+public:
+  static constexpr int MAX_ROWS      = 240;
+  static constexpr int BAND_ROWS     = 24;
+  static constexpr int LIST_CAPACITY = 1024;
+  static constexpr int REF_CAPACITY  = 16;    // caller tables per banded frame
+  static constexpr int SPRITE_RUNS   = 24;    // runs per sprite mask
+  static constexpr int CORNER_CACHE  = 4;     // round-rect corner shapes kept
+  static constexpr int CORNER_MAX_R  = 64;    // larger corners use the GFX path
+
+  BubuCanvas(uint16_t w, uint16_t h);
+
+  // ---- GFX overrides (all primitives funnel through these) ----
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void fillScreen(uint16_t color) override;
+
+  // Not virtual in Adafruit_GFX: these hide the base versions so calls on the
+  // canvas record a single display-list op. Calls through Adafruit_GFX& still
+  // work, they just record the decomposed rects.
+  // fillRoundRect() stamps one span per row from a small LRU of corner
+  // shapes (per radius), pixel-identical to the GFX version.
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+  // Pixels cut from each end of row k of that round rect (same cache)
+  int  roundRectInset(int w, int h, int r, int k);
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    int16_t x2, int16_t y2, uint16_t color);
+
+  // Ring rIn < d <= rOut around (x0, y0): only the ring's spans are written,
+  // so nothing inside is painted (unlike a disc filled over a disc).
+  void fillAnnulus(int16_t x0, int16_t y0, int16_t rIn, int16_t rOut, uint16_t color);
+
+  // ---- Sprites ----
+  // A mask is a small pre-rasterized shape as runs [x0, x1) on row dy around
+  // the stamp point. stampBatch() draws n instances in one loop with one
+  // visibility test each; wholly visible ones are written straight into the
+  // store. Banded frames record the batch as one op, so masks and instances
+  // must stay valid until present.
+  struct SpriteRun { int8_t dy, x0, x1; };
+  struct SpriteMask {
+    uint8_t   runs = 0;
+    int8_t    top = 0, bottom = 0, left = 0, right = 0;   // bounds, bottom/right exclusive
+    SpriteRun run[SPRITE_RUNS];
+    void add(int dy, int x0, int x1);
+  };
+  struct Sprite { int16_t x, y; uint16_t color; uint8_t mask; };
+  void stampBatch(const SpriteMask *masks, const Sprite *s, int n);
+
+  // Radial gradient in one pass: pixel (dx, dy) gets lut[dx*dx + dy*dy],
+  // for every dx*dx + dy*dy <= r*r. lut must stay valid until present.
+  void fillRadial(int16_t x0, int16_t y0, int16_t r, const uint16_t *lut);
+
+  // ---- Pixel order ----
+  enum class PixelOrder : uint8_t { HOST, PANEL };
+  void setPixelOrder(PixelOrder order);
+  bool panelOrder() const { return swapped; }
+  uint16_t toRaw(uint16_t c) const   { return swapped ? (uint16_t)((c >> 8) | (c << 8)) : c; }
+  uint16_t fromRaw(uint16_t r) const { return toRaw(r); }
+  uint16_t getPixel(int16_t x, int16_t y) const {
+    if (half) {
+      if ((uint16_t)x >= (uint16_t)_width || (uint16_t)y >= (uint16_t)_height) return 0;
+      return fromRaw(pix[(y >> 1) * (WIDTH / 2) + (x >> 1)]);
+    }
+    return fromRaw(GFXcanvas16::getPixel(x, y));
+  }
+
+  // ---- Round panel ----
+  void setRound(bool on);
+  bool isRound() const { return round; }
+  int  rowStart(int y) const { return span0[y]; }
+  int  rowEnd(int y) const   { return span1[y]; }
+
+  // ---- Raster mode ----
+  // Switching reallocates the store and carries the picture over (list
+  // replay or resampling). Returns false (mode unchanged) when the memory
+  // is not available.
+  enum class Raster : uint8_t { FULL, BANDED, HALF };
+  bool setRaster(Raster r);
+  Raster raster() const { return mode; }
+  bool isBanded() const  { return banded; }
+  bool isHalfRes() const { return half; }
+  void rasterBand(int y0, int y1);        // replay the list into rows [y0, y1)
+  bool listOverflowed() const { return overflowed; }   // this frame spilled to full mode
+  bool listDropped() const    { return dropped; }      // ...and the spill failed: ops were lost
+
+  // Pixels of row y: the full buffer, the current band, or (half) a
+  // pixel-doubled line that is only valid until the next call
+  const uint16_t *rowPtr(int y) { return half ? expandRow(y) : pix + (y - bandY0) * WIDTH; }
+
+  // ---- Brightness ----
+  // Scale every channel by (f + 1) / 256, so f = 255 is the identity.
+  static uint16_t dim565(uint16_t c, uint8_t f) {
+    const uint32_t k = f + 1u;
+    return (uint16_t)((((c >> 11) * k >> 8) << 11) |
+                      ((((c >> 5) & 0x3F) * k >> 8) << 5) |
+                      ((c & 0x1F) * k >> 8));
+  }
+  // dim565() over every visible stored pixel, two per 32-bit word, skipping
+  // black runs; marks the frame dirty. No-op while banded.
+  void dim(uint8_t f);
+
+  // ---- Alpha blending (reads the store: no-op while banded) ----
+  // alpha 0..255, quantized to 1/32 steps; 50% and 25% have exact
+  // shift-and-add paths.
+  void blendSpan(int y, int x0, int x1, uint16_t color, uint8_t alpha);
+  void blendCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color, uint8_t alpha);
+
+  // ---- Damage ----
+  // Code that writes getBuffer() directly must report it, or the panel
+  // will not see the change.
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+  void markAllDirty();
+
+  // Dirty span of row y for this present (this frame ∪ last presented frame,
+  // since anything drawn last frame may have been erased). False if clean.
+  bool dirtyRow(int y, int16_t &x0, int16_t &x1) const;
+  int  dirtyTop() const    { return curTop < prevTop ? curTop : prevTop; }
+  int  dirtyBottom() const { return curBottom > prevBottom ? curBottom : prevBottom; } // exclusive
+
+  void endFrame();     // frame was presented: this frame becomes "previous"
+  void carryFrame();   // present skipped: keep this frame's damage pending
+
+protected:
+  enum OpKind : uint8_t { OP_RECT, OP_CIRCLE, OP_ROUNDRECT, OP_TRIANGLE, OP_RADIAL, OP_ANNULUS, OP_SPRITES };
+  struct Op {
+    uint8_t  kind, top, bottom;   // rows [top, bottom) the op can touch
+    int16_t  v[6];
+    uint16_t color;
+  };
+
+  inline bool recording() const { return banded && !replaying && nest == 0; }
+  inline void touchRow(int y, int x0, int x1) {
+    if (x0 < cur0[y]) cur0[y] = (uint8_t)x0;
+    if (x1 > cur1[y]) cur1[y] = (uint8_t)x1;
+    if (y < curTop)     curTop = y;
+    if (y >= curBottom) curBottom = y + 1;
+  }
+  // Recording only tracks damage; replaying writes the band without
+  // touching damage again.
+  inline void fillSpan(int y, int x0, int x1, uint16_t color) {
+    if (x0 < span0[y]) x0 = span0[y];
+    if (x1 > span1[y]) x1 = span1[y];
+    if (x0 >= x1) return;
+    if (half) { halfSpan(y, x0, x1, color); return; }
+    if (replaying) {
+      if (y < bandY0 || y >= bandY1) return;
+    } else {
+      touchRow(y, x0, x1);
+      if (banded) return;
+    }
+    color = toRaw(color);
+    uint16_t *p = pix + (y - bandY0) * WIDTH + x0;
+    for (int n = x1 - x0; n > 0; --n) *p++ = color;
+  }
+  void clearRows(uint8_t *r0, uint8_t *r1, int &top, int &bottom);
+  Op  *addOp(uint8_t kind, int top, int bottom, uint16_t color);
+  void spill();
+  void recordRect(int x, int y, int w, int h, uint16_t color);
+  void replay(int y0, int y1);
+  void halfSpan(int y, int x0, int x1, uint16_t color);
+  int  lockSpan(int y, int x0, int x1, uint16_t *&p);
+  void radialRows(int x0, int y0, int r, const uint16_t *lut);
+  void annulusRows(int x0, int y0, int rIn, int rOut, uint16_t color);
+  void spriteRows(const SpriteMask *masks, const Sprite *s, int n);
+  int  addRefs(const void *a, const void *b = nullptr);
+  void roundRectRows(int x, int y, int w, int h, int r, uint16_t color);
+  const uint8_t *cornerInsets(int r);
+  void radialSpan(int y, int x0, int x1, int cx, int32_t dy2, const uint16_t *lut);
+  const uint16_t *expandRow(int y);
+
+  bool swapped = false;   // PixelOrder::PANEL
+
+  // visible span per row (whole row unless round)
+  bool    round = false;
+  uint8_t span0[MAX_ROWS], span1[MAX_ROWS];
+
+  // raster state; pix is where fillSpan writes (buffer, band or half store)
+  Raster    mode = Raster::FULL;
+  bool      banded = false, half = false;
+  bool      replaying = false, overflowed = false, dropped = false;
+  bool      listCleared = false;   // list starts with a full-screen fill
+  uint8_t   nest = 0;              // >0 while a recorded shape decomposes
+  uint16_t *pix = nullptr;
+  uint16_t *band = nullptr;
+  uint16_t *line = nullptr;        // half: pixel-doubled row for rowPtr()
+  Op       *ops = nullptr;
+  int       opCount = 0;
+  const void *refs[REF_CAPACITY];       // caller tables the ops point at
+  int       refCount = 0;
+
+  // round-rect corners: inset[k] = pixels cut from each end of corner row k
+  struct Corner {
+    int16_t  r = -1;
+    uint16_t used = 0;              // LRU stamp
+    uint8_t  inset[CORNER_MAX_R];
+  };
+  Corner   corners[CORNER_CACHE];
+  uint16_t cornerClock = 0;
+  int       bandY0 = 0, bandY1 = MAX_ROWS;
+
+  // per-row dirty intervals, [x0, x1); empty when x0 >= x1
+  uint8_t cur0[MAX_ROWS],  cur1[MAX_ROWS];
+  uint8_t prev0[MAX_ROWS], prev1[MAX_ROWS];
+  int curTop, curBottom, prevTop, prevBottom;
+
+  // fillScreen() with the same colour as the last clear is not damage:
+  // everything outside the tracked rows already has that colour on the panel.
+  // Only holds while every frame starts with a clear and nobody pokes the
+  // buffer behind our back.
+  uint16_t bgColor = 0;
+  bool     bgValid = false;
+  bool     clearedThisFrame = false;
+};
@@ -0,0 +1,16 @@
+#include "bubu_colors.h"
+
+namespace BubuColors {
+
+static constexpr uint16_t hueAt(int h) {
+  return (h >> 5) == 0 ? rgb565(255, (h & 31) << 3, 0)
+       : (h >> 5) == 1 ? rgb565(255 - ((h & 31) << 3), 255, 0)
+       : (h >> 5) == 2 ? rgb565(0, 255, (h & 31) << 3)
+       : (h >> 5) == 3 ? rgb565(0, 255 - ((h & 31) << 3), 255)
+       : (h >> 5) == 4 ? rgb565((h & 31) << 3, 0, 255)
+       :                 rgb565(255, 0, 255 - ((h & 31) << 3));
+}
+
+constexpr Table<HUE_STEPS> HUE = generate<HUE_STEPS, hueAt>();
+
+} // namespace BubuColors
@@ -0,0 +1,60 @@
+#pragma once
+#include <Arduino.h>
+
+// Shared RGB565 colour tables.
+// Every table is generated at compile time from the formula it is built
+// with and lives in flash; per-frame code only indexes it.
+namespace BubuColors {
+
+// Same packing as Adafruit_GFX::color565(), usable in constant expressions
+constexpr uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
+  return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+template<int N> struct Table {
+  uint16_t v[N];
+  constexpr uint16_t operator[](int i) const { return v[i]; }
+  constexpr int size() const { return N; }
+};
+
+// ---- Hue wheel ----
+// Six 32-step segments: red, yellow, green, cyan, blue, magenta, back to red.
+constexpr int HUE_STEPS = 192;
+extern const Table<HUE_STEPS> HUE;
+inline uint16_t hue(uint8_t h) { return HUE[h]; }    // h < HUE_STEPS
+
+// ---- Table generators ----
+namespace detail {
+  template<int... I> struct Seq {};
+  template<int N, int... I> struct MakeSeq : MakeSeq<N - 1, N - 1, I...> {};
+  template<int... I> struct MakeSeq<0, I...> { typedef Seq<I...> type; };
+
+  template<uint16_t (*F)(int), int... I>
+  constexpr Table<sizeof...(I)> generate(Seq<I...>) { return {{ F(I)... }}; }
+
+  constexpr int r8(uint16_t c) { return ((c >> 11) & 0x1F) << 3; }
+  constexpr int g8(uint16_t c) { return ((c >> 5) & 0x3F) << 2; }
+  constexpr int b8(uint16_t c) { return (c & 0x1F) << 3; }
+  // a + (b - a) * s(i / n), s(t) = t*t*(3 - 2t), truncated like the float ramp
+  constexpr int easeCh(int a, int b, int i, int n) {
+    return a + (b - a) * i * i * (3 * n - 2 * i) / (n * n * n);
+  }
+  constexpr uint16_t rampAt(uint16_t from, uint16_t to, int i, int n) {
+    return rgb565(easeCh(r8(from), r8(to), i, n), easeCh(g8(from), g8(to), i, n),
+                  easeCh(b8(from), b8(to), i, n));
+  }
+  template<int... I>
+  constexpr Table<sizeof...(I)> ramp(uint16_t from, uint16_t to, Seq<I...>) {
+    return {{ rampAt(from, to, I, (int)sizeof...(I) - 1)... }};
+  }
+}
+
+// Table of F(0) .. F(N-1); F must be constexpr
+template<int N, uint16_t (*F)(int)>
+constexpr Table<N> generate() { return detail::generate<F>(typename detail::MakeSeq<N>::type()); }
+
+// N colours eased (smoothstep) from `from` to `to`, both ends included
+template<int N>
+constexpr Table<N> ramp(uint16_t from, uint16_t to) { return detail::ramp(from, to, typename detail::MakeSeq<N>::type()); }
+
+} // namespace BubuColors
@@ -1,10 +1,11 @@
 #include "bubu_emotions.h"
 #include "emotion_engine.h"   // access the shared canvas/tft from NE
+#include "present_engine.h"
+#include "frame_pacer.h"
+#include "helpers.h"
 
 // ===== Reuse the SAME canvas that emotion_engine uses =====
-// Make sure emotion_engine.h exposes:  extern GFXcanvas16 canvas;
-// and that emotion_engine.cpp defines it.
-extern GFXcanvas16 canvas;
+// (emotion_engine.h exposes:  extern BubuCanvas canvas;)
 
 namespace {
 
@@ -25,11 +26,12 @@ inline void drawEye(int x, int y, int w, int h) {
   canvas.fillRoundRect(x - w/2, y - h/2, w, h, EYE_R, 0xFFFF);
 }
 
-inline void flush(Adafruit_GC9A01A& tft) {
-  tft.drawRGBBitmap(0, 0, canvas.getBuffer(), CANVAS_W, CANVAS_H);
+inline void flush(Adafruit_GC9A01A&) {
+  if (FramePacer::presentDue()) PresentEngine::present(canvas);   // pushes only what changed
+  else                          canvas.carryFrame();
 }
 
-inline void frameDelay(uint32_t ms = 16) { delay(ms); }
+inline void frameDelay() { FramePacer::endFrame(); }
 
 } // namespace
 
@@ -47,177 +49,126 @@ void BubuEmotions::showIdle(Adafruit_GC9A01A& tft) {
   drawEye(rx, CY, EYE_SIZE, EYE_SIZE);
   flush(tft);
 }
-//=======================================TURN LEFT=======================================//
-void BubuEmotions::playTurnLeft(Adafruit_GC9A01A& tft) {
-  int leftX  = CX - 50;
-  int rightX = CX + 50;
-  const int eyeW = EYE_SIZE, eyeH = EYE_SIZE;
-
-  int phase = 0;
-  int rightMergeSpeed = 5;
-  unsigned long holdStart = 0;
+// ===== MTE keyframes =====
+// Each key eases from the previous pose to its own over ms.
+// Timings follow the old per-frame steps at 30 fps.
+namespace {
 
-  for (;;) {
-    flush();
-    switch (phase) {
-      case 0: // travel left
-        if (leftX > eyeW/2) { leftX -= 7; rightX -= 5; }
-        else { phase = 1; }
-        break;
-
-      case 1: // merge (right eye catches up)
-        if (rightX > leftX + 2) {
-          rightMergeSpeed = min(20, int(rightMergeSpeed * 1.5f));
-          rightX -= rightMergeSpeed;
-        } else { phase = 2; holdStart = millis(); }
-        break;
-
-      case 2: // brief hold
-        if (millis() - holdStart >= 300) phase = 3;
-        break;
-
-      case 3: // return to center
-        if (rightX < CX + 50) rightX += 5;
-        if (leftX  > CX - 50) leftX  -= 5;
-        if (rightX >= CX + 50 && leftX <= CX - 50) { phase = 4; holdStart = millis(); }
-        break;
-
-      case 4: // settle hold then FINISH (NO wrap to phase 0)
-        if (millis() - holdStart >= 300) { showIdle(tft); return; }
-        break;
-    }
-    drawEye(leftX, CY, eyeW, eyeH);
-    drawEye(rightX, CY, eyeW, eyeH);
-    flush(tft);
-    frameDelay();
+enum Ease : uint8_t { LINEAR, EASE_IN, EASE_OUT, EASE_IN_OUT };
+
+struct Pose { int16_t lx, rx, size; };
+struct Key  { uint16_t ms; Ease ease; Pose to; };
+struct Track { const Key *keys; uint8_t count; uint8_t homeKey; };   // keys from homeKey on return to idle
+
+constexpr Pose IDLE_POSE = { CX - EYE_SPACING/2, CX + EYE_SPACING/2, EYE_SIZE };
+
+const Key TURN_LEFT_KEYS[] = {
+  { 170, EASE_OUT,    { EYE_SIZE/2, CX + 25, EYE_SIZE } },            // travel left
+  { 200, EASE_IN,     { EYE_SIZE/2, EYE_SIZE/2 + 2, EYE_SIZE } },     // right eye catches up
+  { 300, LINEAR,      { EYE_SIZE/2, EYE_SIZE/2 + 2, EYE_SIZE } },     // brief hold
+  { 900, EASE_IN_OUT, IDLE_POSE },                                    // return to center
+  { 300, LINEAR,      IDLE_POSE },                                    // settle
+};
+const Key TURN_RIGHT_KEYS[] = {
+  { 170, EASE_OUT,    { CX - 25, CANVAS_W - EYE_SIZE/2, EYE_SIZE } },
+  { 200, EASE_IN,     { CANVAS_W - EYE_SIZE/2 - 2, CANVAS_W - EYE_SIZE/2, EYE_SIZE } },
+  { 300, LINEAR,      { CANVAS_W - EYE_SIZE/2 - 2, CANVAS_W - EYE_SIZE/2, EYE_SIZE } },
+  { 900, EASE_IN_OUT, IDLE_POSE },
+  { 300, LINEAR,      IDLE_POSE },
+};
+const Key SPEED_UP_KEYS[] = {
+  {  80, EASE_OUT, { IDLE_POSE.lx, IDLE_POSE.rx, 90 } },             // expand fast
+  { 500, LINEAR,   { IDLE_POSE.lx, IDLE_POSE.rx, 90 } },             // short hold
+  { 400, EASE_IN,  IDLE_POSE },                                       // ease back
+  { 300, LINEAR,   IDLE_POSE },                                       // rest
+};
+const Key BRAKES_KEYS[] = {
+  { 500, EASE_IN, { CX - 30, CX + 30, 50 } },                         // shrink & close
+  { 600, LINEAR,  { CX - 30, CX + 30, 50 } },                         // hold small
+  { 500, EASE_IN, IDLE_POSE },                                        // reopen
+  { 300, LINEAR,  IDLE_POSE },                                        // rest
+};
+
+#define MTE_TRACK(keys, home) { keys, (uint8_t)(sizeof(keys) / sizeof(keys[0])), home }
+const Track TRACKS[] = {
+  { nullptr, 0, 0 },                  // NONE
+  MTE_TRACK(TURN_LEFT_KEYS, 3),
+  MTE_TRACK(TURN_RIGHT_KEYS, 3),
+  MTE_TRACK(SPEED_UP_KEYS, 2),
+  MTE_TRACK(BRAKES_KEYS, 2),
+};
+#undef MTE_TRACK
+
+// ---- playback state ----
+BubuEmotions::Anim anim    = BubuEmotions::Anim::NONE;
+BubuEmotions::Anim pending = BubuEmotions::Anim::NONE;
+uint8_t  key      = 0;
+uint32_t keyStart = 0;
+Pose     from     = IDLE_POSE;   // pose at the start of the current key
+Pose     pose     = IDLE_POSE;   // last drawn
+
+HE_q16 ease(Ease e, HE_q16 t) {
+  switch (e) {
+    case EASE_IN:     return HE_mulQ16(t, t);
+    case EASE_OUT:    return HE_easeOutQ16(t);
+    case EASE_IN_OUT: return HE_easeInOutQ16(t);
+    default:          return t;
   }
 }
 
-//=======================================TURN RIGHT=======================================//
-void BubuEmotions::playTurnRight(Adafruit_GC9A01A& tft) {
-  int leftX  = CX - 50;
-  int rightX = CX + 50;
-  const int eyeW = EYE_SIZE, eyeH = EYE_SIZE;
+Pose lerpPose(const Pose &a, const Pose &b, HE_q16 t) {
+  return { (int16_t)HE_lerpI(a.lx, b.lx, t), (int16_t)HE_lerpI(a.rx, b.rx, t),
+           (int16_t)HE_lerpI(a.size, b.size, t) };
+}
 
-  int phase = 0;
-  int leftMergeSpeed = 5;
-  unsigned long holdStart = 0;
+} // namespace
 
-  for (;;) {
-    flush();
-    switch (phase) {
-      case 0: // travel right
-        if (rightX < CANVAS_W - eyeW/2) { rightX += 7; leftX += 5; }
-        else { phase = 1; }
-        break;
-
-      case 1: // merge (left eye catches up)
-        if (leftX < rightX - 2) {
-          leftMergeSpeed = min(20, int(leftMergeSpeed * 1.5f));
-          leftX += leftMergeSpeed;
-        } else { phase = 2; holdStart = millis(); }
-        break;
-
-      case 2: // brief hold
-        if (millis() - holdStart >= 300) phase = 3;
-        break;
-
-      case 3: // return to center
-        if (leftX  > CX - 50) leftX  -= 5;
-        if (rightX < CX + 50) rightX += 5;
-        if (rightX >= CX + 50 && leftX <= CX - 50) { phase = 4; holdStart = millis(); }
-        break;
-
-      case 4: // settle hold then FINISH
-        if (millis() - holdStart >= 300) { showIdle(tft); return; }
-        break;
-    }
-    drawEye(leftX, CY, eyeW, eyeH);
-    drawEye(rightX, CY, eyeW, eyeH);
-    flush(tft);
-    frameDelay();
-  }
+void BubuEmotions::start(Anim a, uint32_t now) {
+  if (a == Anim::NONE) return;
+  from     = (anim == Anim::NONE) ? IDLE_POSE : pose;   // a cut picks up where the eyes are
+  anim     = a;
+  pending  = Anim::NONE;
+  key      = 0;
+  keyStart = now;
 }
-// ===== SPEED UP =====
-void BubuEmotions::playSpeedUp(Adafruit_GC9A01A& tft) {
-  const int spacing = EYE_SPACING;
-  int size = EYE_SIZE;
-  float v = 0;
-  int phase = 0;
-  unsigned long holdStart = 0;
 
-  for (;;) {
-    flush();
-    switch (phase) {
-      case 0: // expand fast
-        v = min(15.0f, v + 7.0f);
-        size += int(v);
-        if (size >= 90) { size = 90; v = 0; phase = 1; holdStart = millis(); }
-        break;
-
-      case 1: // short hold
-        if (millis() - holdStart >= 500) phase = 2;
-        break;
-
-      case 2: // ease back
-        v = min(3.5f, v + 0.4f);
-        size -= int(v);
-        if (size <= EYE_SIZE) { size = EYE_SIZE; v = 0; phase = 3; holdStart = millis(); }
-        break;
-
-      case 3: // rest then FINISH
-        if (millis() - holdStart >= 300) { showIdle(tft); return; }
-        break;
-    }
-    int lx = CX - spacing/2;
-    int rx = CX + spacing/2;
-    drawEye(lx, CY, size, size);
-    drawEye(rx, CY, size, size);
-    flush(tft);
-    frameDelay();
-  }
+void BubuEmotions::queue(Anim a) { pending = a; }
+
+BubuEmotions::Anim BubuEmotions::playing() { return anim; }
+
+bool BubuEmotions::homeward() {
+  return anim != Anim::NONE && key >= TRACKS[(int)anim].homeKey;
 }
 
-// ===== BRAKES =====
-void BubuEmotions::playBrakes(Adafruit_GC9A01A& tft) {
-  float size = EYE_SIZE;
-  float spacing = 90.0f;
-  float sizeV = 0.0f, spacingV = 0.0f;
-  int phase = 0;
-  unsigned long holdStart = 0;
+bool BubuEmotions::step(uint32_t now) {
+  if (anim == Anim::NONE) return false;
 
+  // advance past finished keys (several if a frame ran long)
   for (;;) {
-    flush();
-    switch (phase) {
-      case 0: // shrink & close
-        sizeV    = min(2.5f, sizeV + 0.25f);
-        spacingV = min(2.5f, spacingV + 0.25f);
-        size    = max(50.0f, size - sizeV);
-        spacing = max(60.0f, spacing - spacingV);
-        if (size <= 50.0f && spacing <= 60.0f) { phase = 1; holdStart = millis(); }
-        break;
-
-      case 1: // hold small
-        if (millis() - holdStart >= 600) phase = 2;
-        break;
-
-      case 2: // reopen
-        sizeV    = min(2.5f, sizeV + 0.25f);
-        spacingV = min(2.5f, spacingV + 0.25f);
-        size    = min<float>(EYE_SIZE, size + sizeV);
-        spacing = min<float>(90.0f, spacing + spacingV);
-        if (size >= EYE_SIZE && spacing >= 90.0f) { phase = 3; holdStart = millis(); }
-        break;
-
-      case 3: // rest then FINISH
-        if (millis() - holdStart >= 300) { showIdle(tft); return; }
-        break;
+    const Track &tr = TRACKS[(int)anim];
+    const Key &k = tr.keys[key];
+    if (now - keyStart < k.ms) break;
+    keyStart += k.ms;
+    from = k.to;
+    if (++key < tr.count) continue;
+    if (pending == Anim::NONE) {       // done: the last key is the idle pose
+      anim = Anim::NONE;
+      pose = IDLE_POSE;
+      return false;
     }
-    int lx = CX - int(spacing/2);
-    int rx = CX + int(spacing/2);
-    drawEye(lx, CY, int(size), int(size));
-    drawEye(rx, CY, int(size), int(size));
-    flush(tft);
-    frameDelay();
+    pose = from;
+    start(pending, keyStart);          // chain
   }
-}
\ No newline at end of file
+
+  const Key &k = TRACKS[(int)anim].keys[key];
+  pose = lerpPose(from, k.to, ease(k.ease, HE_ratioQ16(now - keyStart, k.ms)));
+
+  // eyes are hard-edged: draw them from the display list, not at half res
+  if (!canvas.setRaster(BubuCanvas::Raster::BANDED)) canvas.setRaster(BubuCanvas::Raster::FULL);
+  flush();
+  drawEye(pose.lx, CY, pose.size, pose.size);
+  drawEye(pose.rx, CY, pose.size, pose.size);
+  flush(tft);
+  frameDelay();
+  return true;
+}
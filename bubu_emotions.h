@@ -11,9 +11,17 @@ namespace BubuEmotions {
   // Neutral/idle frame (two centered eyes)
   void showIdle(Adafruit_GC9A01A& tft);
 
-  // MTE animations (blocking ~5 s each), return to idle when done
-  void playTurnLeft(Adafruit_GC9A01A& tft);
-  void playTurnRight(Adafruit_GC9A01A& tft);
-  void playSpeedUp(Adafruit_GC9A01A& tft);
-  void playBrakes(Adafruit_GC9A01A& tft);
-}
\ No newline at end of file
+  // ---- MTE animations (non-blocking) ----
+  // Timed keyframes, one frame per step(); they end on the idle pose.
+  enum class Anim : uint8_t { NONE, TURN_LEFT, TURN_RIGHT, SPEED_UP, BRAKES };
+
+  // Start a (cuts the one in flight, which hands over its current pose)
+  void start(Anim a, uint32_t now);
+  // Play a right after the current animation (latest request wins)
+  void queue(Anim a);
+  // Draw, present and pace one frame; false (nothing drawn) once finished
+  bool step(uint32_t now);
+
+  Anim playing();
+  bool homeward();   // past the hold, heading back to idle
+}
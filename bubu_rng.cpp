@@ -0,0 +1,34 @@
+#include "bubu_rng.h"
+
+namespace BubuRng {
+
+static uint32_t sessionSeed = 0;
+static Stream   streams[STREAM_COUNT];
+static bool     seeded = false;
+
+// splitmix-style finalizer: nearby seeds give unrelated streams
+static uint32_t mix(uint32_t x) {
+  x ^= x >> 16; x *= 0x85EBCA6Bu;
+  x ^= x >> 13; x *= 0xC2B2AE35u;
+  x ^= x >> 16;
+  return x;
+}
+
+void setSeed(uint32_t s) {
+  if (s == 0) s = 0xA5F0361Du;
+  sessionSeed = s;
+  for (int i = 0; i < STREAM_COUNT; ++i) {
+    uint32_t x = mix(s + (uint32_t)(i + 1) * 0x9E3779B9u);
+    streams[i].s = x ? x : 1;                    // xorshift must not start at 0
+  }
+  seeded = true;
+}
+
+uint32_t seed() { return sessionSeed; }
+
+Stream &stream(Id id) {
+  if (!seeded) setSeed(0);
+  return streams[id];
+}
+
+} // namespace BubuRng
@@ -0,0 +1,56 @@
+#pragma once
+#include <Arduino.h>
+
+// Seeded pseudo-random streams (xorshift32).
+// Every emotion draws from its own stream, so one emotion taking more or
+// fewer numbers never shifts another's sequence. All streams derive from a
+// single session seed: the same setSeed() value replays a session exactly.
+// Ranges use a multiply-high instead of a division.
+namespace BubuRng {
+
+enum Id : uint8_t {
+  ENGINE,       // cycle picking, idle timing, NORMAL/SAD wander and blinks
+  IDLE_TINT,
+  BOOT_INTRO,
+  SAD,
+  CONFUSE,
+  CYCLOP,
+  EASE,         // HE_jitteredEaseQ16 noise (DOUBT, ANGRY2)
+  DOUBT,
+  SMILE,
+  BANH_CHUNG,
+  DEADPOOL,
+  CARVE,
+  SLEEPY,
+  FIREWORKS,
+  FORTUNE,
+  STREAM_COUNT
+};
+
+struct Stream {
+  uint32_t s;
+
+  uint32_t next() {
+    uint32_t x = s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return s = x;
+  }
+  // 0 .. n-1
+  uint32_t below(uint32_t n) { return (uint32_t)(((uint64_t)next() * n) >> 32); }
+  // lo .. hi-1, like random(lo, hi)
+  int32_t range(int32_t lo, int32_t hi) { return lo + (int32_t)below((uint32_t)(hi - lo)); }
+  bool coin() { return (int32_t)next() < 0; }
+  uint8_t byte() { return (uint8_t)(next() >> 24); }
+
+  void fill(uint32_t *dst, int n) { while (n-- > 0) *dst++ = next(); }
+  void fillRange(int *dst, int n, int lo, int hi) { while (n-- > 0) *dst++ = range(lo, hi); }
+};
+
+// Re-derive every stream from seed (0 is replaced by a fixed constant)
+void setSeed(uint32_t seed);
+uint32_t seed();
+Stream &stream(Id id);
+
+} // namespace BubuRng
@@ -1,12 +1,16 @@
 #include "emotion_engine.h"
 #include "helpers.h"
 #include "fortune_teller.h"
+#include "present_engine.h"
+#include "frame_pacer.h"
+#include "bubu_colors.h"
+#include "bubu_rng.h"
 #include <U8g2_for_Adafruit_GFX.h>
 #include <math.h>
 
 // ===== Hardware objects (same as master) =====
 Adafruit_GC9A01A tft(TFT_CS, TFT_DC, TFT_RST);
-GFXcanvas16 canvas(240, 240);
+BubuCanvas canvas(240, 240);
 U8G2_FOR_ADAFRUIT_GFX u8g2;
 
 // === Global Settings ===
@@ -20,52 +24,6 @@ int eyeCorner = 20;
 // === Emotion Cycle ===
 EmotionType currentEmotion = NORMAL;
 unsigned long emotionStartTime = 0;
-unsigned long emotionDuration[] = {
-  8000, // Normal
-  8000, // Sad
-  8000, // Confuse
-  8000, // Love
-  8000, // Cyclop
-  7000, // Shock
-  8000, // Drunk
-  6000, // Furious
-  6000, // Angry
-  8000, // Doubt
-  8000, // Angry2
-  8000,  // Smile
-  8000,  // Banh_chung
-  8000, // DeadPool
-  8000,  //Fortune_teller
-  65000, //CARVE_SESSION
-  65000,   //SLEEPY
-  8000,    //CRY
-  32000      //FIREWORKS
- };
-// Weighted selection for non-NORMAL emotions.
-// Units are arbitrary (they don't have to sum to 100).
-// Index mapping: {NORMAL, SAD, CONFUSE, LOVE, CYCLOP, SHOCK, DRUNK, FURIOUS, ANGRY, DOUBT, ANGRY2, SMILE.......}
-static uint8_t emotionWeight[19] = { 
-  0,   // NORMAL (unused by picker)
-  15,  // SAD
-  15,  // CONFUSE
-  40,  // LOVE
-  15,  // CYCLOP
-  15,  // SHOCK
-  20,  // DRUNK
-  1,  // FURIOUS
-  15,  // ANGRY
-  15,  // DOUBT
-  10,   // ANGRY2
-  30,   // SMILE
-  1,   // BANH_CHUNG
-  15,  //DEADPOOL
-  10,   //FORTUNE_TELLER
-  40,   //carved_session
-  15,   //SLEEPY
-  10,    //CRY
-  15    //FIREWORKS
-};
-
 // ===== Idle Background Tint (random, drifting hue) ==================
 // Turn on/off globally:
 static const bool IDLE_BG_TINT_ENABLED = true;
@@ -74,40 +32,48 @@ static const uint8_t IDLE_BG_MIN_F     = 32;    // darker
 static const uint8_t IDLE_BG_MAX_F     = 96;    // brighter
 static const uint32_t IDLE_HUE_HOLD_MS = 2500;  // sit on a hue
 static const uint32_t IDLE_HUE_FADE_MS = 1800;  // crossfade time
-static const float    IDLE_BREATH_HZ   = 0.10f; // brightness breathing
+static const uint32_t IDLE_BREATH_MS   = 10000; // brightness breathing period
 bool gPreserveBackground = false;
 
-// If you already have bi_dim565/bi_hue2rgb565 from intro, you can use those.
-static inline uint16_t idle_dim565(uint16_t c,uint8_t f){
-  uint8_t r5=(c>>11)&31, g6=(c>>5)&63, b5=c&31;
-  uint8_t r=(r5<<3)|(r5>>2), g=(g6<<2)|(g6>>4), b=(b5<<3)|(b5>>2);
-  r=(uint8_t)(((uint16_t)r*f)>>8);
-  g=(uint8_t)(((uint16_t)g*f)>>8);
-  b=(uint8_t)(((uint16_t)b*f)>>8);
-  return ((r&0xF8)<<8)|((g&0xFC)<<3)|(b>>3);
-}
-static inline uint16_t idle_hue2rgb565(uint8_t hue){
-  uint8_t seg=hue>>5, off=(hue&31)<<3, r=0,g=0,b=0;
-  switch(seg){
-    case 0: r=255;       g=off;       b=0;   break;
-    case 1: r=255-off;   g=255;       b=0;   break;
-    case 2: r=0;         g=255;       b=off; break;
-    case 3: r=0;         g=255-off;   b=255; break;
-    case 4: r=off;       g=0;         b=255; break;
-    default:r=255;       g=0;         b=255-off;     break;
-  }
-  return ((r&0xF8)<<8)|((g&0xFC)<<3)|(b>>3);
-}
+// ===== Present mode =====
+// ASYNC streams frame N by DMA while frame N+1 renders (falls back to
+// BLOCKING if the second frame buffer can't be allocated).
+static const PresentEngine::Mode PRESENT_MODE = PresentEngine::Mode::ASYNC;
+// RGB444 sends 12-bit pixels (3 bytes per 2): 25% less SPI time per frame.
+static const PresentEngine::Format PRESENT_FORMAT = PresentEngine::Format::RGB444;
+
+// ===== Frame pacing =====
+// Fixed frame period; late frames drop their present, not their update.
+static const uint8_t TARGET_FPS = 30;
+
+// ===== Randomness =====
+// Session seed for every emotion's random stream. 0 = fresh hardware seed
+// each boot; any other value replays the same session.
+static const uint32_t RNG_SEED = 0;
+static inline BubuRng::Stream &rng(BubuRng::Id id) { return BubuRng::stream(id); }
+
+// ===== Render modes =====
+// BANDED: the emotion redraws everything each frame and never reads pixels
+//   back, so it is drawn into a display list and rasterized band by band at
+//   present time (no 115 KB buffer).
+// HALF:   soft, per-pixel-heavy effects render at 120x120 and are doubled
+//   on the way to the panel.
+// FULL:   everything else.
+static const bool RENDER_BANDED = true;
+static const uint32_t PRESENT_STAGING_BYTES =
+    RENDER_BANDED ? 2u * 240 * BubuCanvas::BAND_ROWS * 2 : 0;  // 0 = one full frame
+typedef BubuCanvas::Raster Raster;
+static int bandSpillEmotion = -1;   // last emotion whose frames overflowed the list
 
 static uint8_t  idleHueFrom = 0, idleHueTo = 64;
 static unsigned long idlePhaseStart = 0;
 static bool idleTintInited = false;
 
-static uint8_t idle_hueLerp(uint8_t a, uint8_t b, float t){
+static uint8_t idle_hueLerp(uint8_t a, uint8_t b, HE_q16 t){
   int da = b - a;
   if (da > 96)  da -= 192;
   if (da < -96) da += 192;
-  int h = (int)roundf(a + da * t);
+  int h = HE_lerpI(a, a + da, t);
   if (h < 0)    h += 192;
   if (h >= 192) h -= 192;
   return (uint8_t)h;
@@ -115,8 +81,8 @@ static uint8_t idle_hueLerp(uint8_t a, uint8_t b, float t){
 
 static void drawIdleTintBackground(unsigned long now){
   if(!idleTintInited){
-    idleHueFrom = (uint8_t)(esp_random() % 192);
-    idleHueTo   = (uint8_t)(esp_random() % 192);
+    idleHueFrom = (uint8_t)rng(BubuRng::IDLE_TINT).below(BubuColors::HUE_STEPS);
+    idleHueTo   = (uint8_t)rng(BubuRng::IDLE_TINT).below(BubuColors::HUE_STEPS);
     idlePhaseStart = now;
     idleTintInited = true;
   }
@@ -127,29 +93,28 @@ static void drawIdleTintBackground(unsigned long now){
   if (phaseElapsed < IDLE_HUE_HOLD_MS){
     hue = idleHueFrom;
   } else if (phaseElapsed < IDLE_HUE_HOLD_MS + IDLE_HUE_FADE_MS){
-    float t = (phaseElapsed - IDLE_HUE_HOLD_MS) / (float)IDLE_HUE_FADE_MS;
-    t = t*t*(3.f - 2.f*t); // ease
+    HE_q16 t = HE_smoothQ16(HE_ratioQ16(phaseElapsed - IDLE_HUE_HOLD_MS, IDLE_HUE_FADE_MS));
     hue = idle_hueLerp(idleHueFrom, idleHueTo, t);
   } else {
     idleHueFrom = idleHueTo;
-    uint8_t step = 24 + (esp_random() % 64); // 24..87
-    idleHueTo = (uint8_t)((idleHueFrom + step) % 192);
+    uint8_t step = 24 + rng(BubuRng::IDLE_TINT).below(64); // 24..87
+    idleHueTo = (uint8_t)((idleHueFrom + step) % BubuColors::HUE_STEPS);
     idlePhaseStart = now;
     hue = idleHueFrom;
   }
 
-  float breath = 0.5f + 0.5f * sinf(2.0f * 3.1415926f * IDLE_BREATH_HZ * (now / 1000.0f));
-  uint8_t f = (uint8_t)(IDLE_BG_MIN_F + (IDLE_BG_MAX_F - IDLE_BG_MIN_F) * breath);
+  HE_q16 breath = (HE_Q16_ONE + HE_sinQ16(HE_angleMs(now, IDLE_BREATH_MS))) >> 1;   // 0..1
+  uint8_t f = (uint8_t)(IDLE_BG_MIN_F + HE_scaleI(IDLE_BG_MAX_F - IDLE_BG_MIN_F, breath));
 
-  canvas.fillScreen( idle_dim565( idle_hue2rgb565(hue), f ) );
+  canvas.fillScreen( BubuCanvas::dim565( BubuColors::hue(hue), f ) );
 }
 
-// === NORMAL & SAD Movement ===
-float eyeOffsetX = 0, eyeOffsetY = 0;
-float targetX = 0, targetY = 0;
+// === NORMAL & SAD Movement (Q16 pixels) ===
+HE_q16 eyeOffsetX = 0, eyeOffsetY = 0;
+HE_q16 targetX = 0, targetY = 0;
 unsigned long lastMoveTime = 0;
 int moveInterval = 1000;
-float easing = 0.1;
+HE_q16 easing = HE_toQ16(0.1f);
 
 // === NORMAL Blink ===
 enum BlinkState { IDLE, CLOSING, CLOSED, OPENING };
@@ -157,43 +122,51 @@ BlinkState normalBlinkState = IDLE;
 unsigned long blinkStart = 0;
 int blinkDuration = 150;
 unsigned long nextBlinkTime = 0;
-float blinkProgress = 0.0;
+HE_q16 blinkProgress = 0;   // 0 = open, HE_Q16_ONE = shut
 
 // === SAD Rain ===
 const int numDrops = 40;
 int dropX[numDrops], dropY[numDrops], dropSpeed[numDrops];
+static BubuCanvas::Sprite rainSprites[numDrops];   // stamped as 1x8 streaks
+// drop shades: rgb(b, b, b + 30) for b = 50..150
+static constexpr uint16_t rainShade(int i) { return BubuColors::rgb565(50 + i, 50 + i, 80 + i); }
+static constexpr BubuColors::Table<101> RAIN_SHADES = BubuColors::generate<101, rainShade>();
 
 // === CONFUSE Fog ===
 const int numFog = 25;
-float fogX[numFog], fogY[numFog], angle[numFog], radius[numFog];
+int fogX[numFog], fogY[numFog], fogRadius[numFog];
+uint32_t fogAngle[numFog];   // binary angle in the top 16 bits
 int fogSize[numFog];
 uint16_t fogColor[numFog];
 bool swapState = false;
 unsigned long lastSwitch = 0;
 
 // ==== LOVE (heart eyes + cheek glow) ====
-static uint16_t loveColor;
+static const uint16_t loveColor = BubuColors::rgb565(255, 0, 160);  // pink eyes
 
 static int  heartW = 20;          // ellipse half-width
 static int  heartH = 30;          // ellipse half-height
 static float tiltDeg = 45.0f;     // heart lobes tilt
 static int  bobAmplitude = 4;     // eye bobbing (px)
-static float bobSpeedMs = 300.0f; // bob speed (ms divisor)
+static uint32_t bobPeriodMs = 1885; // bob period (300 ms per radian)
 
 // Cheek glow tuning (lightweight)
 static const int CHEEK_RINGS      = 8;     // fewer = faster
-static float     cheekHz          = 0.55f; // pulse frequency
+static uint32_t  cheekPeriodMs    = 1818;  // pulse period (0.55 Hz)
 static int       cheekBaseRadius  = 35;    // average glow radius
 static int       cheekPulseAmp    = 6;     // +/- radius change
 static int       cheekYOffset     = 60;    // below eyes
 static int       cheekXOffset     = 130;   // horizontal from eye centers
-static uint16_t  cheekInnerColor;          // set in setup
-static uint16_t  cheekOuterColor;          // set in setup
+// rings from the darker rim to the soft pink core
+static constexpr BubuColors::Table<CHEEK_RINGS> CHEEK_RAMP =
+    BubuColors::ramp<CHEEK_RINGS>(BubuColors::rgb565(40, 0, 35), BubuColors::rgb565(255, 60, 170));
 static bool g_carveSessionDone = false;
 
 // === CYCLOP Eye ===
-float cyclopScale = 1.0, scalePhase = 0.0;
-float pupilX = 0, pupilY = 0, targetPX = 0, targetPY = 0;
+HE_q16 cyclopScale = HE_Q16_ONE;
+uint16_t cyclopPhase = 0;                  // binary angle
+HE_q16 pupilX = 0, pupilY = 0;
+int targetPX = 0, targetPY = 0;
 unsigned long lastCyclopMove = 0;
 bool cyclopPaused = false;
 
@@ -202,7 +175,7 @@ unsigned long shockStartTime = 0;
 bool shockBlinked = false;
 
 // === DRUNK ===
-float phaseLeft = 0, phaseRight = 0;
+uint16_t phaseLeft = 0, phaseRight = 0;   // binary angles
 
 // ------------------------------------------------------------------
 // NEW: Cycle state machine (NORMAL is the hub)
@@ -213,13 +186,119 @@ CycleState cycleState = CycleState::NORMAL_IDLE;   // matches `extern` in .h
 static uint32_t normalPhaseStart = 0;
 static uint32_t normalIdleTargetMs = 0;        // randomized 3–8 s each time
 static const uint16_t RECENTER_PIX_TOL = 1;    // snap-to-center tolerance
-static const float    RECENTER_EASE    = 0.20f; // easing when recentering
-// Forward declaration so we can call it from triggerRandomEmotion()
+static const HE_q16   RECENTER_EASE    = HE_toQ16(0.20f); // easing when recentering
+static const HE_q16   RECENTER_DONE    = HE_toQ16(0.2f);  // offset (px) that counts as centred
+// Forward declarations of emotion draw functions
+static void drawNormal(unsigned long now);
+static void drawSad(unsigned long now);
+static void drawConfuse(unsigned long now);
+static void drawLove(unsigned long now);
+static void drawCyclop(unsigned long now);
+static void drawShock(unsigned long now);
+static void drawDrunk(unsigned long now);
+static void drawFurious(unsigned long now);
+static void drawAngry(unsigned long now);
+static void drawDoubt(unsigned long now);
+static void drawAngry2(unsigned long now);
+static void drawSmile(unsigned long now);
+static void drawBanhChung(unsigned long now);
+static void drawDEADPOOL(unsigned long now);
+static void drawCARVE_SESSION(unsigned long now);
+static void drawSLEEPY(unsigned long now);
+static void drawCRY(unsigned long now);
+static void drawFIREWORKS(unsigned long now);
+static bool drawBOOT_INTRO(unsigned long now);  // forward declaration
+
+// ===== Emotion table =====
+// One row per EmotionType, in enum order. The loop looks the current
+// emotion up here instead of switching on it.
+//   step      draws one frame; false = finished early
+//   duration  ms before returning to NORMAL (0 = step decides)
+//   weight    odds of being picked from NORMAL, arbitrary units (0 = never)
+//   clear     BLACK, KEEP (the effect fades the previous frame) or TINT (idle hue)
+//   raster    see Render modes above
+//   present   false when the emotion draws straight to the panel; the shared
+//             canvas is then left alone (no raster switch, no clear)
+//   budgetUs  expected busy time per frame (reported with FRAME_BUDGET_LOG)
+enum class Clear : uint8_t { BLACK, KEEP, TINT };
+struct EmotionDesc {
+  EmotionType id;
+  const char *name;
+  bool (*step)(unsigned long now);
+  uint32_t durationMs;
+  uint8_t  weight;
+  void (*onBegin)(uint32_t durationMs);
+  void (*onEnd)(uint32_t now);
+  Clear    clear;
+  Raster   raster;
+  bool     present;
+  uint16_t budgetUs;
+};
+
+template<void (*DRAW)(unsigned long)>
+static bool timedStep(unsigned long now) { DRAW(now); return true; }
+
+static bool normalStep(unsigned long now) { drawNormal(now); return false; }  // one frame, then idle
+static bool fortuneStep(unsigned long)    { return FortuneTeller::loop(); }
+static void fortuneBegin(uint32_t durationMs) { FortuneTeller::begin(durationMs); }
+static void fortuneEnd(uint32_t)          { FortuneTeller::end(); }
+static void carveBegin(uint32_t)          { g_carveSessionDone = false; }
+static bool bootIntroStep(unsigned long now) { return !drawBOOT_INTRO(now); }
+static void bootIntroEnd(uint32_t now)    { currentEmotion = NORMAL; emotionStartTime = now; }
+
+static const uint16_t FRAME_US = 1000000u / TARGET_FPS;
+
+static constexpr EmotionDesc EMOTIONS[] = {
+  // id              name          step                        ms     wt  begin         end           clear         raster          present budget
+  { NORMAL,         "NORMAL",     normalStep,                 0,      0, nullptr,      nullptr,      Clear::TINT,  Raster::BANDED, true,  FRAME_US },
+  { SAD,            "SAD",        timedStep<drawSad>,         8000,  15, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { CONFUSE,        "CONFUSE",    timedStep<drawConfuse>,     8000,  15, nullptr,      nullptr,      Clear::BLACK, Raster::HALF,   true,  FRAME_US },  // fog blends over canvas pixels
+  { LOVE,           "LOVE",       timedStep<drawLove>,        8000,  40, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { CYCLOP,         "CYCLOP",     timedStep<drawCyclop>,      8000,  15, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { SHOCK,          "SHOCK",      timedStep<drawShock>,       7000,  15, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { DRUNK,          "DRUNK",      timedStep<drawDrunk>,       8000,  20, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { FURIOUS,        "FURIOUS",    timedStep<drawFurious>,     6000,   1, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { ANGRY,          "ANGRY",      timedStep<drawAngry>,       6000,  15, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { DOUBT,          "DOUBT",      timedStep<drawDoubt>,       8000,  15, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { ANGRY2,         "ANGRY2",     timedStep<drawAngry2>,      8000,  10, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { SMILE,          "SMILE",      timedStep<drawSmile>,       8000,  30, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { BANH_CHUNG,     "BANH_CHUNG", timedStep<drawBanhChung>,   8000,   1, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { DEADPOOL,       "DEADPOOL",   timedStep<drawDEADPOOL>,    8000,  15, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { FORTUNE_TELLER, "FORTUNE",    fortuneStep,                8000,  10, fortuneBegin, fortuneEnd,   Clear::KEEP,  Raster::BANDED, false, FRAME_US },  // own canvas, direct to panel
+  { CARVE_SESSION,  "CARVE",      timedStep<drawCARVE_SESSION>, 65000, 40, carveBegin, nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { SLEEPY,         "SLEEPY",     timedStep<drawSLEEPY>,      65000, 15, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { CRY,            "CRY",        timedStep<drawCRY>,         8000,  10, nullptr,      nullptr,      Clear::BLACK, Raster::BANDED, true,  FRAME_US },
+  { FIREWORKS,      "FIREWORKS",  timedStep<drawFIREWORKS>,   32000, 15, nullptr,      nullptr,      Clear::KEEP,  Raster::HALF,   true,  FRAME_US },  // fades the previous frame
+  { BOOT_INTRO,     "BOOT_INTRO", bootIntroStep,              0,      0, nullptr,      bootIntroEnd, Clear::BLACK, Raster::HALF,   true,  FRAME_US },  // rings + canvas dims
+};
+
+static constexpr bool emotionRowsInOrder(int i) {
+  return i == EMOTION_COUNT || (EMOTIONS[i].id == i && emotionRowsInOrder(i + 1));
+}
+static_assert(sizeof(EMOTIONS) / sizeof(EMOTIONS[0]) == EMOTION_COUNT, "EMOTIONS needs one row per EmotionType");
+static_assert(emotionRowsInOrder(0), "EMOTIONS rows must follow EmotionType order");
+static_assert(EMOTIONS[NORMAL].weight == 0, "NORMAL is the idle state, not a pick");
+
+// ===== Frame budget =====
+static const bool FRAME_BUDGET_LOG = false;   // Serial report when an emotion runs over
+static uint16_t budgetFrames = 0, budgetOver = 0;
+static uint16_t budgetDropped = 0;   // frames that lost ops: list full and no memory to spill
+
+static void budgetReport(const EmotionDesc &d) {
+  if (FRAME_BUDGET_LOG && budgetOver)
+    Serial.printf("budget: %s %u/%u frames over %u us\n", d.name,
+                  (unsigned)budgetOver, (unsigned)budgetFrames, (unsigned)d.budgetUs);
+  if (FRAME_BUDGET_LOG && budgetDropped)
+    Serial.printf("budget: %s %u/%u frames dropped ops (list spill failed)\n", d.name,
+                  (unsigned)budgetDropped, (unsigned)budgetFrames);
+  budgetFrames = budgetOver = budgetDropped = 0;
+}
+
 static EmotionType pickWeightedEmotion();
 static void startNormalIdle(uint32_t now) {
   cycleState = CycleState::NORMAL_IDLE;
   normalPhaseStart = now;
-  normalIdleTargetMs = random(3000, 8001); // 3–8 seconds
+  normalIdleTargetMs = rng(BubuRng::ENGINE).range(3000, 8001); // 3–8 seconds
 }
 
 // Implement the non-static function declared in the header
@@ -228,54 +307,27 @@ void triggerRandomEmotion(uint32_t now) {
   currentEmotion = e;
   emotionStartTime = now;
   cycleState = CycleState::PLAY_EMOTION;
-  if (currentEmotion == CARVE_SESSION) g_carveSessionDone = false;
   // Start stateful modules on entry
-  if (currentEmotion == FORTUNE_TELLER) {
-    FortuneTeller::begin(emotionDuration[FORTUNE_TELLER]);
-  }
+  const EmotionDesc &d = EMOTIONS[currentEmotion];
+  if (d.onBegin) d.onBegin(d.durationMs);
 }
 
-// FIXED: Corrected array bounds for emotion selection
 static EmotionType pickWeightedEmotion() {
-  // auto-size based on emotionWeight[]
-  const int count = sizeof(emotionWeight) / sizeof(emotionWeight[0]);
-
   uint16_t total = 0;
-  for (int i = 1; i < count; ++i) {   // skip NORMAL at 0
-    total += emotionWeight[i];
+  for (int i = 1; i < EMOTION_COUNT; ++i) {   // skip NORMAL at 0
+    total += EMOTIONS[i].weight;
   }
   if (total == 0) return SAD; // fallback if all weights are zero
 
-  uint16_t r = (uint16_t)random(1, total + 1);
+  uint16_t r = (uint16_t)rng(BubuRng::ENGINE).range(1, total + 1);
   uint16_t acc = 0;
-  for (int i = 1; i < count; ++i) {
-    acc += emotionWeight[i];
+  for (int i = 1; i < EMOTION_COUNT; ++i) {
+    acc += EMOTIONS[i].weight;
     if (r <= acc) return (EmotionType)i;
   }
   return SAD; // safety fallback
 }
 
-// Forward declarations of emotion draw functions
-static void drawNormal(unsigned long now);
-static void drawSad(unsigned long now);
-static void drawConfuse(unsigned long now);
-static void drawLove(unsigned long now);
-static void drawCyclop(unsigned long now);
-static void drawShock(unsigned long now);
-static void drawDrunk(unsigned long now);
-static void drawFurious(unsigned long now);
-static void drawAngry(unsigned long now);
-static void drawDoubt(unsigned long now);
-static void drawAngry2(unsigned long now);
-static void drawSmile(unsigned long now);
-static void drawBanhChung(unsigned long now);
-static void drawDEADPOOL(unsigned long now);
-static void drawCARVE_SESSION(unsigned long now);
-static void drawSLEEPY(unsigned long now);
-static void drawCRY(unsigned long now);
-static void drawFIREWORKS(unsigned long now);
-static bool drawBOOT_INTRO(unsigned long now);  // forward declaration
-
 void bubuEngineRestartCycle() {
   // Recenter & restart NORMAL idle window
   cycleState = CycleState::NORMAL_IDLE;
@@ -283,11 +335,11 @@ void bubuEngineRestartCycle() {
   // Reset timers/targets so the cycle truly restarts fresh
   emotionStartTime   = millis();
   normalPhaseStart   = millis();
-  normalIdleTargetMs = random(3000, 8001); // 3–8s idle
+  normalIdleTargetMs = rng(BubuRng::ENGINE).range(3000, 8001); // 3–8s idle
 
   // Optional: snap eyes near center so the restart looks clean
-  eyeOffsetX = 0.0f;
-  eyeOffsetY = 0.0f;
+  eyeOffsetX = 0;
+  eyeOffsetY = 0;
 
   // Optional: clear canvas immediately (prevents lingering MTE frame if any)
   canvas.fillScreen(GC9A01A_BLACK);
@@ -296,14 +348,19 @@ void bubuEngineRestartCycle() {
 // ===== Public "setup/loop" equivalents =====
 void bubuEngineSetup() {
   Serial.begin(115200);
-  SPI.begin(4, -1, 3);
+  SPI.begin(TFT_SCK, -1, TFT_MOSI);
   tft.begin();
   tft.setRotation(3);
   tft.fillScreen(GC9A01A_BLACK);
-  randomSeed(analogRead(0));
+  canvas.setRound(true);             // GC9A01A is a circle: skip the corners
+  canvas.setPixelOrder(BubuCanvas::PixelOrder::PANEL);   // present = plain copy
+  PresentEngine::begin(&tft, PRESENT_MODE, PRESENT_STAGING_BYTES);
+  PresentEngine::setFormat(PRESENT_FORMAT);
+  FramePacer::setTargetFps(TARGET_FPS);
+  BubuRng::setSeed(RNG_SEED ? RNG_SEED : esp_random());
   FortuneTeller::setup(&tft);
   emotionStartTime = millis();
-  nextBlinkTime = millis() + random(1000, 3000);
+  nextBlinkTime = millis() + rng(BubuRng::ENGINE).range(1000, 3000);
   lastMoveTime = millis();
 
   u8g2.begin(canvas);
@@ -313,18 +370,18 @@ void bubuEngineSetup() {
   u8g2.setForegroundColor(GC9A01A_WHITE);
   
   for (int i = 0; i < numDrops; i++) {
-    dropX[i] = random(0, 240);
-    dropY[i] = random(0, 240);
-    dropSpeed[i] = random(1, 12);
+    dropX[i] = rng(BubuRng::SAD).range(0, 240);
+    dropY[i] = rng(BubuRng::SAD).range(0, 240);
+    dropSpeed[i] = rng(BubuRng::SAD).range(1, 12);
   }
 
   for (int i = 0; i < numFog; i++) {
     fogX[i] = 120;
     fogY[i] = 120;
-    angle[i] = random(0, 628) / 100.0;
-    radius[i] = random(30, 100);
-    fogSize[i] = random(5, 21);
-    fogColor[i] = tft.color565(random(100, 255), random(100, 255), random(100, 255));
+    fogAngle[i] = rng(BubuRng::CONFUSE).next() & 0xFFFF0000u;
+    fogRadius[i] = rng(BubuRng::CONFUSE).range(30, 100);
+    fogSize[i] = rng(BubuRng::CONFUSE).range(5, 21);
+    fogColor[i] = BubuColors::rgb565(rng(BubuRng::CONFUSE).range(100, 255), rng(BubuRng::CONFUSE).range(100, 255), rng(BubuRng::CONFUSE).range(100, 255));
   }
 
   shockStartTime = millis();
@@ -332,29 +389,34 @@ void bubuEngineSetup() {
   // NEW: start in NORMAL idle phase
   startNormalIdle(millis());
   // LOVE: colors
-  loveColor       = tft.color565(255, 0, 160);  // pink eyes
-  cheekInnerColor = tft.color565(255, 60, 170); // soft pink core
-  cheekOuterColor = tft.color565( 40,  0,  35); // darker rim
 }
 
 void bubuEngineLoop() {
   uint32_t now = millis();
   bool stillActive = false;
-  bool skipClear = (cycleState == CycleState::PLAY_EMOTION && currentEmotion == FIREWORKS);
 
-  // Only clear if we’re not preserving a background
-  if (!skipClear && !gPreserveBackground) {
-    canvas.fillScreen(GC9A01A_BLACK);
+  const EmotionType renderKey = (cycleState == CycleState::PLAY_EMOTION) ? currentEmotion : NORMAL;
+  const EmotionDesc &d = EMOTIONS[renderKey];
+  const EmotionDesc *budgeted = nullptr;   // emotion this frame's cost is charged to
+  bool budgetDone = false;
+
+  if (d.present) {                 // direct-to-panel emotions never show the canvas
+    Raster raster = d.raster;
+    if (raster == Raster::BANDED && (!RENDER_BANDED || renderKey == bandSpillEmotion)) raster = Raster::FULL;
+    canvas.setRaster(raster);
+
+    // Only clear if we’re not preserving a background
+    if (d.clear == Clear::TINT) {
+      drawIdleTintBackground(now);   // fills the whole screen
+    } else if (d.clear == Clear::BLACK && !gPreserveBackground) {
+      canvas.fillScreen(GC9A01A_BLACK);
+    }
   }
 
   switch (cycleState) {
   case CycleState::NORMAL_IDLE: {
     // Wander + blink
-    gPreserveBackground = true;
-    drawIdleTintBackground(now);  
-    gPreserveBackground = false;   // ← tint first
-    drawNormal(now);                 // ← eyes on top
-    
+    drawNormal(now);                 // ← eyes on top of the tint
 
     // After random idle, begin recenter
     if (now - normalPhaseStart >= normalIdleTargetMs) {
@@ -364,80 +426,60 @@ void bubuEngineLoop() {
 
     case CycleState::NORMAL_RECENTER: {
     // Ease offsets back to center
-    eyeOffsetX += (0.0f - eyeOffsetX) * RECENTER_EASE;
-    eyeOffsetY += (0.0f - eyeOffsetY) * RECENTER_EASE;
+    eyeOffsetX -= HE_mulQ16(eyeOffsetX, RECENTER_EASE);
+    eyeOffsetY -= HE_mulQ16(eyeOffsetY, RECENTER_EASE);
 
     // Render a frame while recentering
-    gPreserveBackground = true;
-    drawIdleTintBackground(now);                           // ← tint
-    drawBlinkingEyes(centerX + eyeOffsetX, centerY + eyeOffsetY, blinkProgress);
-    gPreserveBackground = false;
+    drawBlinkingEyes(centerX + HE_roundQ16(eyeOffsetX), centerY + HE_roundQ16(eyeOffsetY), blinkProgress);
 
-    if (fabsf(eyeOffsetX) < 0.2f && fabsf(eyeOffsetY) < 0.2f) {
+    if (abs(eyeOffsetX) < RECENTER_DONE && abs(eyeOffsetY) < RECENTER_DONE) {
     triggerRandomEmotion(now);
     }
   } break;
 
     case CycleState::PLAY_EMOTION: {
-      stillActive = false;
-
-      switch (currentEmotion) {
-        case NORMAL: { gPreserveBackground = true; drawIdleTintBackground(now); drawNormal(now); gPreserveBackground = false; break; }
-        case SAD:     drawSad(now);     stillActive = (now - emotionStartTime <= emotionDuration[SAD]);     break;
-        case CONFUSE: drawConfuse(now); stillActive = (now - emotionStartTime <= emotionDuration[CONFUSE]); break;
-        case LOVE:    drawLove(now);    stillActive = (now - emotionStartTime <= emotionDuration[LOVE]);    break;
-        case CYCLOP:  drawCyclop(now);  stillActive = (now - emotionStartTime <= emotionDuration[CYCLOP]);  break;
-        case SHOCK:   drawShock(now);   stillActive = (now - emotionStartTime <= emotionDuration[SHOCK]);   break;
-        case DRUNK:   drawDrunk(now);   stillActive = (now - emotionStartTime <= emotionDuration[DRUNK]);   break;
-        case FURIOUS: drawFurious(now); stillActive = (now - emotionStartTime <= emotionDuration[FURIOUS]); break;
-        case ANGRY:   drawAngry(now);   stillActive = (now - emotionStartTime <= emotionDuration[ANGRY]);   break;
-        case DOUBT:   drawDoubt(now);   stillActive = (now - emotionStartTime <= emotionDuration[DOUBT]);   break;
-        case ANGRY2:  drawAngry2(now);  stillActive = (now - emotionStartTime <= emotionDuration[ANGRY2]);  break;
-        case SMILE:  drawSmile(now);  stillActive = (now - emotionStartTime <= emotionDuration[SMILE]);  break;
-        case BANH_CHUNG:  drawBanhChung(now);   stillActive = (now - emotionStartTime <= emotionDuration[BANH_CHUNG]);  break;
-        case DEADPOOL:  drawDEADPOOL(now);  stillActive = (now - emotionStartTime <= emotionDuration[DEADPOOL]);  break;
-        case FORTUNE_TELLER:  stillActive = FortuneTeller::loop();  break;
-        case CARVE_SESSION: drawCARVE_SESSION(now);   stillActive = (now - emotionStartTime <= emotionDuration[CARVE_SESSION]);   break;
-        case SLEEPY:  drawSLEEPY(now);  stillActive = (now - emotionStartTime <= emotionDuration[SLEEPY]);  break;
-        case CRY:  drawCRY(now);  stillActive = (now - emotionStartTime <= emotionDuration[CRY]);  break;
-        case FIREWORKS:       drawFIREWORKS(now);        stillActive = (now - emotionStartTime <= emotionDuration[FIREWORKS]);      break;
-        case BOOT_INTRO: {
-  bool done = drawBOOT_INTRO(now);
-  stillActive = !done;
-  if (done) {
-    currentEmotion   = NORMAL;   // after intro, go to normal eyes
-    emotionStartTime = now;
-  }
-  break;
-}
-      }
-    if (!stillActive) {
-      // Teardown stateful modules
-      if (currentEmotion == FORTUNE_TELLER) {
-      FortuneTeller::end();
-      }
-      cycleState = CycleState::RETURN_TO_NORMAL;
+      stillActive = d.step(now) && (d.durationMs == 0 || now - emotionStartTime <= d.durationMs);
+      budgeted = &d;
+      if (!stillActive) {
+        // Teardown stateful modules
+        if (d.onEnd) d.onEnd(now);
+        budgetDone = true;
+        cycleState = CycleState::RETURN_TO_NORMAL;
       }
     } break;
 
     case CycleState::RETURN_TO_NORMAL: {
       // Place eyes near center and resume NORMAL idle
-      eyeOffsetX = (random(0, 2) == 0) ? -1.0f : 1.0f;
-      eyeOffsetY = (random(0, 2) == 0) ? -1.0f : 1.0f;
+      eyeOffsetX = (rng(BubuRng::ENGINE).range(0, 2) == 0) ? -HE_Q16_ONE : HE_Q16_ONE;
+      eyeOffsetY = (rng(BubuRng::ENGINE).range(0, 2) == 0) ? -HE_Q16_ONE : HE_Q16_ONE;
 
       // One transitional NORMAL frame (optional)
-      drawBlinkingEyes(centerX + eyeOffsetX, centerY + eyeOffsetY, blinkProgress);
+      drawBlinkingEyes(centerX + HE_roundQ16(eyeOffsetX), centerY + HE_roundQ16(eyeOffsetY), blinkProgress);
 
       // Re-arm NORMAL idle window
       startNormalIdle(now);
     } break;
+
+    default: break;
+  }
+
+  // Present the frame (skip while an emotion is drawing straight to the panel:
+  // the one drawn this frame, which left the canvas alone, or the one just
+  // started, which has already drawn)
+  if (canvas.listOverflowed()) bandSpillEmotion = renderKey;   // too busy for the list: stay full
+  if (canvas.listDropped() && budgetDropped < 0xFFFF) ++budgetDropped;
+  if (d.present && (cycleState != CycleState::PLAY_EMOTION || EMOTIONS[currentEmotion].present)) {
+    if (FramePacer::presentDue()) PresentEngine::present(canvas);
+    else                          canvas.carryFrame();   // late: damage rides on the next present
   }
+  FramePacer::endFrame();
 
-  // Present the frame (skip while Fortune Teller is actively drawing)
-  if (!(cycleState == CycleState::PLAY_EMOTION && currentEmotion == FORTUNE_TELLER)) {
-  tft.drawRGBBitmap(0, 0, canvas.getBuffer(), 240, 240);
+  // lastWorkUs() now covers this frame, present included
+  if (budgeted) {
+    ++budgetFrames;
+    if (FramePacer::lastWorkUs() > budgeted->budgetUs) ++budgetOver;
+    if (budgetDone) budgetReport(*budgeted);
   }
-  delay(20);
 }
 
 // ===============================
@@ -445,19 +487,19 @@ void bubuEngineLoop() {
 // ===============================
 // External engine globals/handlers
 extern Adafruit_GC9A01A tft;
-extern GFXcanvas16      canvas;
+extern BubuCanvas       canvas;
 
 extern int centerX, centerY;
 extern int eyeWidth, eyeHeight, eyeCorner, eyeDistance;
 extern void drawNormal(unsigned long now);
-extern void drawBlinkingEyes(float cx, float cy, float progress);
+extern void drawBlinkingEyes(int cx, int cy, HE_q16 progress);
 
 // ---- knobs ----
 static const uint16_t BI_RING_PHASE_MS   = 2000;
 static const uint8_t  BI_RING_COUNT      = 6;
 static const int      BI_RING_THICKNESS  = 5;
-static const float    BI_RING_SPACING    = 16.f;
-static const float    BI_RING_MAX_R      = 100.f;
+static const int      BI_RING_SPACING    = 16;
+static const int      BI_RING_MAX_R      = 100;
 static const uint16_t BI_EYES_FADE_MS    = 2000;   // eyes fade in from black
 static const uint16_t BI_BLINK_MS        = 200;
 // --- background tint knobs ---
@@ -467,54 +509,30 @@ static const uint8_t BI_BG_MAX_F    = 90;     // 0..255 dim at brightest (ring p
 static const float BI_BG_HUE_SWEEP  = 64.f;   // how much hue drifts over the ring phase
 
 // ---- helpers ----
-static inline float bi_clampf(float x,float a,float b){ return x<a?a:(x>b?b:x); }
-static inline float bi_easeOut(float t){ t=bi_clampf(t,0.f,1.f); return 1.f-(1.f-t)*(1.f-t); }
-static inline float bi_easeInOut(float t){ t=bi_clampf(t,0.f,1.f); return t*t*(3.f-2.f*t); }
-
-static inline uint16_t bi_dim565(uint16_t c,uint8_t f){
-  uint8_t r5=(c>>11)&31, g6=(c>>5)&63, b5=c&31;
-  uint8_t r=(r5<<3)|(r5>>2), g=(g6<<2)|(g6>>4), b=(b5<<3)|(b5>>2);
-  r=(uint8_t)(((uint16_t)r*f)>>8);
-  g=(uint8_t)(((uint16_t)g*f)>>8);
-  b=(uint8_t)(((uint16_t)b*f)>>8);
-  return ((r&0xF8)<<8)|((g&0xFC)<<3)|(b>>3);
-}
+
 static void bi_dimCanvas(uint8_t f){
-  uint16_t *buf = (uint16_t*)canvas.getBuffer();
-  for (int i=0, N=240*240; i<N; ++i) buf[i] = bi_dim565(buf[i], f);
-}
-static inline uint16_t bi_hue2rgb565(uint8_t hue){
-  uint8_t seg=hue>>5, off=(hue&31)<<3, r=0,g=0,b=0;
-  switch(seg){
-    case 0:r=255;       g=off;       b=0;   break;
-    case 1:r=255-off;   g=255;       b=0;   break;
-    case 2:r=0;         g=255;       b=off; break;
-    case 3:r=0;         g=255-off;   b=255; break;
-    case 4:r=off;       g=0;         b=255; break;
-    default:r=255;      g=0;         b=255-off; break;
-  }
-  return ((r&0xF8)<<8)|((g&0xFC)<<3)|(b>>3);
+  canvas.dim(f);                          // visible pixels, two per word
 }
-static void bi_drawRing(float radius, uint16_t baseCol){
-  int r0 = (int)roundf(radius);
-  for(int t=0; t<BI_RING_THICKNESS; ++t){
-    int rr = r0 + t - BI_RING_THICKNESS/2;
-    if (rr <= 0) continue;
-    float k   = bi_clampf(1.f - (radius/BI_RING_MAX_R), 0.f, 1.f);
-    uint8_t f = (uint8_t)(80 + 160*k); // 80..240 soften toward edge
-    canvas.drawCircle(centerX, centerY, rr, bi_dim565(baseCol, f));
-  }
+static void bi_drawRing(HE_q16 radius, uint16_t baseCol){
+  int r0 = (radius + HE_Q16_HALF) >> 16;
+  int rIn  = r0 - BI_RING_THICKNESS/2 - 1;            // exclusive
+  int rOut = r0 + BI_RING_THICKNESS - 1 - BI_RING_THICKNESS/2;
+  if (rOut <= 0) return;
+  if (rIn < 0) rIn = 0;
+  HE_q16 k  = HE_clampQ16(HE_Q16_ONE - radius / BI_RING_MAX_R);
+  uint8_t f = (uint8_t)(80 + HE_scaleI(160, k)); // 80..240 soften toward edge
+  canvas.fillAnnulus(centerX, centerY, rIn, rOut, BubuCanvas::dim565(baseCol, f));
 }
 
 // ---- palette per cycle ----
 static uint16_t bi_palette[BI_RING_COUNT];
 static uint8_t  bi_baseHue=0, bi_hueStep=0;
 static inline void bi_regenPalette(){
-  bi_baseHue = (uint8_t)(esp_random() % 192);
-  bi_hueStep = (uint8_t)(8 + (esp_random() % 32)); // 8..39
+  bi_baseHue = (uint8_t)rng(BubuRng::BOOT_INTRO).below(BubuColors::HUE_STEPS);
+  bi_hueStep = (uint8_t)(8 + rng(BubuRng::BOOT_INTRO).below(32)); // 8..39
   for (uint8_t i=0;i<BI_RING_COUNT;i++){
-    uint8_t h = (uint8_t)(bi_baseHue + i*bi_hueStep) % 192;
-    bi_palette[i] = bi_hue2rgb565(h);
+    uint8_t h = (uint8_t)(bi_baseHue + i*bi_hueStep) % BubuColors::HUE_STEPS;
+    bi_palette[i] = BubuColors::hue(h);
   }
 }
 
@@ -554,12 +572,11 @@ static bool drawBOOT_INTRO(unsigned long now)
     // Phase 1: colorful rings expand
     canvas.fillScreen(GC9A01A_BLACK);
 
-    float t = elapsed / (float)BI_RING_PHASE_MS;  // 0..1
-    float growth = bi_easeOut(t);
+    HE_q16 growth = HE_easeOutQ16(HE_ratioQ16(elapsed, BI_RING_PHASE_MS));  // 0..1
 
     for (uint8_t i = 0; i < BI_RING_COUNT; i++) {
-      float r = (BI_RING_SPACING * i) + growth * BI_RING_MAX_R;
-      if (r <= BI_RING_MAX_R) bi_drawRing(r, bi_palette[i]);
+      HE_q16 r = BI_RING_SPACING * i * HE_Q16_ONE + growth * BI_RING_MAX_R;
+      if (r <= BI_RING_MAX_R * HE_Q16_ONE) bi_drawRing(r, bi_palette[i]);
     }
 
   } else {
@@ -568,16 +585,16 @@ static bool drawBOOT_INTRO(unsigned long now)
 
     canvas.fillScreen(GC9A01A_BLACK);
 
-    bool  blink      = false;
-    float brightness = 1.0f;
+    bool   blink      = false;
+    HE_q16 brightness = HE_Q16_ONE;
 
     if (tEyes < BI_EYES_FADE_MS) {
-      brightness = bi_easeInOut(tEyes / (float)BI_EYES_FADE_MS); // 0→1
+      brightness = HE_smoothQ16(HE_ratioQ16(tEyes, BI_EYES_FADE_MS)); // 0→1
     } else if (tEyes < BI_EYES_FADE_MS + BI_BLINK_MS) {
       blink = true;
-      brightness = 1.0f;
+      brightness = HE_Q16_ONE;
     } else {
-      brightness = 1.0f;
+      brightness = HE_Q16_ONE;
     }
 
     // draw your normal eyes (white) then dim whole frame toward black
@@ -585,14 +602,13 @@ static bool drawBOOT_INTRO(unsigned long now)
       drawNormal(now);
     } else {
       // progress=1 → fully shut line; adapt if your blink API differs
-      drawBlinkingEyes((float)centerX, (float)centerY, 1.0f);
+      drawBlinkingEyes(centerX, centerY, HE_Q16_ONE);
     }
-    uint8_t fade = (uint8_t)(255 * brightness); // 0=black, 255=full
+    uint8_t fade = (uint8_t)HE_scaleI(255, brightness); // 0=black, 255=full
     bi_dimCanvas(fade);
   }
 
-  // present
-  tft.drawRGBBitmap(0, 0, canvas.getBuffer(), 240, 240);
+  // (engine presents the frame)
 
   // done?
   if (elapsed >= BI_TOTAL) {
@@ -604,21 +620,20 @@ static bool drawBOOT_INTRO(unsigned long now)
 // === NORMAL ===
 static void drawNormal(unsigned long now) {
   if (now - lastMoveTime > moveInterval) {
-    targetX = random(-20, 21);
-    targetY = random(-20, 21);
+    targetX = rng(BubuRng::ENGINE).range(-20, 21) * HE_Q16_ONE;
+    targetY = rng(BubuRng::ENGINE).range(-20, 21) * HE_Q16_ONE;
     lastMoveTime = now;
   }
 
-  eyeOffsetX += (targetX - eyeOffsetX) * easing;
-  eyeOffsetY += (targetY - eyeOffsetY) * easing;
+  eyeOffsetX += HE_mulQ16(targetX - eyeOffsetX, easing);
+  eyeOffsetY += HE_mulQ16(targetY - eyeOffsetY, easing);
 
   if (normalBlinkState == IDLE && now > nextBlinkTime) {
     normalBlinkState = CLOSING;
     blinkStart = now;
   } else if (normalBlinkState == CLOSING) {
-    blinkProgress = float(now - blinkStart) / blinkDuration;
-    if (blinkProgress >= 1.0) {
-      blinkProgress = 1.0;
+    blinkProgress = HE_ratioQ16(now - blinkStart, blinkDuration);
+    if (blinkProgress >= HE_Q16_ONE) {
       normalBlinkState = CLOSED;
       blinkStart = now;
     }
@@ -628,41 +643,42 @@ static void drawNormal(unsigned long now) {
       blinkStart = now;
     }
   } else if (normalBlinkState == OPENING) {
-    blinkProgress = 1.0 - float(now - blinkStart) / blinkDuration;
-    if (blinkProgress <= 0.0) {
-      blinkProgress = 0.0;
+    blinkProgress = HE_Q16_ONE - HE_ratioQ16(now - blinkStart, blinkDuration);
+    if (blinkProgress <= 0) {
       normalBlinkState = IDLE;
-      nextBlinkTime = now + random(1000, 3000);
+      nextBlinkTime = now + rng(BubuRng::ENGINE).range(1000, 3000);
     }
   }
 
-  drawBlinkingEyes(centerX + eyeOffsetX, centerY + eyeOffsetY, blinkProgress);
+  drawBlinkingEyes(centerX + HE_roundQ16(eyeOffsetX), centerY + HE_roundQ16(eyeOffsetY), blinkProgress);
 }
 
 // === SAD ===
 static void drawSad(unsigned long now) {
   if (now - lastMoveTime > moveInterval) {
-    targetX = random(-20, 21);
-    targetY = random(-20, 21);
+    targetX = rng(BubuRng::ENGINE).range(-20, 21) * HE_Q16_ONE;
+    targetY = rng(BubuRng::ENGINE).range(-20, 21) * HE_Q16_ONE;
     lastMoveTime = now;
   }
 
-  eyeOffsetX += (targetX - eyeOffsetX) * easing;
-  eyeOffsetY += (targetY - eyeOffsetY) * easing;
+  eyeOffsetX += HE_mulQ16(targetX - eyeOffsetX, easing);
+  eyeOffsetY += HE_mulQ16(targetY - eyeOffsetY, easing);
 
   for (int i = 0; i < numDrops; i++) {
     dropY[i] += dropSpeed[i];
     if (dropY[i] > 240) {
       dropY[i] = 0;
-      dropX[i] = random(0, 240);
+      dropX[i] = rng(BubuRng::SAD).range(0, 240);
     }
-    int alpha = 100 + sin((now + i * 100) / 300.0) * 50;
-    uint8_t b = constrain(alpha, 50, 180);
-    uint16_t color = tft.color565(b, b, b + 30);
-    canvas.drawFastVLine(dropX[i], dropY[i], 8, color);
+    int alpha = 100 + HE_scaleI(50, HE_sinQ16(HE_angleMs(now + i * 100, 1885)));   // 300 ms per radian
+    uint16_t color = RAIN_SHADES[constrain(alpha, 50, 150) - 50];
+    rainSprites[i] = { (int16_t)dropX[i], (int16_t)dropY[i], color, 0 };
   }
+  static BubuCanvas::SpriteMask streak;
+  if (!streak.runs) HE_spriteRect(streak, 1, 8);
+  canvas.stampBatch(&streak, rainSprites, numDrops);
 
-  drawBlinkingEyes(centerX + eyeOffsetX, centerY + eyeOffsetY, blinkProgress);
+  drawBlinkingEyes(centerX + HE_roundQ16(eyeOffsetX), centerY + HE_roundQ16(eyeOffsetY), blinkProgress);
 }
 
 // === CONFUSE ===
@@ -673,10 +689,10 @@ static void drawConfuse(unsigned long now) {
   }
 
   for (int i = 0; i < numFog; i++) {
-    float swirl = 0.002 + (i * 0.0002);
-    angle[i] += swirl;
-    fogX[i] = 120 + cos(angle[i]) * radius[i];
-    fogY[i] = 120 + sin(angle[i]) * radius[i];
+    fogAngle[i] += 1367131 + i * 136713;   // 0.002 + i * 0.0002 rad per frame
+    const uint16_t a = fogAngle[i] >> 16;
+    fogX[i] = 120 + ((HE_cosQ16(a) * fogRadius[i]) >> 16);
+    fogY[i] = 120 + ((HE_sinQ16(a) * fogRadius[i]) >> 16);
     drawCircleWithOpacity(fogX[i], fogY[i], fogSize[i], fogColor[i], 127);
   }
 
@@ -690,81 +706,115 @@ static void drawConfuse(unsigned long now) {
 }
 
 // === LOVE ===
-static inline void putPixelSafe(int x, int y, uint16_t c) {
-  if ((unsigned)x < 240u && (unsigned)y < 240u) canvas.drawPixel(x, y, c);
+// Heart = two tilted ellipses (lobes at cx -/+ 10, tilted -/+ tilt).
+// The union is rasterized once per (w, h, tilt) into per-row spans relative
+// to the centre (at most two per row: the notch), then stamped each frame
+// with one hline per span. Exact pixel-centre coverage, so no pinholes.
+static const int HEART_MAX_ROWS = 160;
+struct HeartSprite {
+  int     w = -1, h = -1;
+  float   tilt = 0;
+  int     top = 0, rows = 0;                        // dy of first row, row count
+  int16_t x0[2][HEART_MAX_ROWS], x1[2][HEART_MAX_ROWS];   // [x0, x1), empty if x0 >= x1
+};
+static HeartSprite heartSprite;
+
+// Pixels of row dy inside one lobe: [x0, x1), empty if x0 >= x1.
+// Radii get +0.5 so the outline matches the old point-sampled size.
+static void heartLobeSpan(int dy, float ox, float angleDeg, int w, int h, int &x0, int &x1) {
+  float angle = angleDeg * DEG_TO_RAD, ca = cosf(angle), sa = sinf(angle);
+  float iw = 1.0f / ((w + 0.5f) * (w + 0.5f)), ih = 1.0f / ((h + 0.5f) * (h + 0.5f));
+  // (u/w)^2 + (v/h)^2 <= 1 with u = x ca + y sa, v = -x sa + y ca, x = dx - ox
+  float A = ca * ca * iw + sa * sa * ih;
+  float B = 2.0f * dy * ca * sa * (iw - ih);
+  float C = dy * dy * (sa * sa * iw + ca * ca * ih) - 1.0f;
+  float disc = B * B - 4.0f * A * C;
+  x0 = 0; x1 = 0;
+  if (disc < 0) return;
+  float q = sqrtf(disc);
+  x0 = (int)ceilf (ox + (-B - q) / (2.0f * A));
+  x1 = (int)floorf(ox + (-B + q) / (2.0f * A)) + 1;
 }
 
-// One heart = two rotated ellipses touching
-static void drawLoveHeartShape(int cx, int cy, int w, int h, float tiltDeg, uint16_t col) {
-  float t = tiltDeg;
-  // left/right lobes (rotate simple filled ellipses)
-  // (we draw directly into canvas to keep it fast)
-  auto drawLoveEllipse = [&](int ex, int ey, int w, int h, float angleDeg, uint16_t col) {
-    float angle = angleDeg * DEG_TO_RAD, ca = cosf(angle), sa = sinf(angle);
-    for (int dy = -h; dy <= h; dy++) {
-      float yRatio = (float)dy / (float)h;
-      float span   = sqrtf(fmaxf(0.0f, 1.0f - yRatio * yRatio)) * (float)w;
-      int x0 = (int)floorf(-span);
-      int x1 = (int) ceilf( span);
-      for (int i = x0; i <= x1; i++) {
-        float xf = (float)i;
-        float xr = xf * ca - (float)dy * sa;
-        float yr = xf * sa + (float)dy * ca;
-        int px = (int)floorf(ex + xr + 0.5f);
-        int py = (int)floorf(ey + yr + 0.5f);
-        putPixelSafe(px, py, col);
-      }
+static const HeartSprite &heartSpriteFor(int w, int h, float tilt) {
+  HeartSprite &hs = heartSprite;
+  if (hs.w == w && hs.h == h && hs.tilt == tilt) return hs;
+  hs.w = w; hs.h = h; hs.tilt = tilt;
+  int ext = w > h ? w : h;
+  hs.top  = -(ext + 1);
+  hs.rows = 2 * (ext + 1) + 1;
+  if (hs.rows > HEART_MAX_ROWS) { hs.top = -HEART_MAX_ROWS / 2; hs.rows = HEART_MAX_ROWS; }
+  for (int i = 0; i < hs.rows; ++i) {
+    int a0, a1, b0, b1;
+    heartLobeSpan(hs.top + i, -10.0f, -tilt, w, h, a0, a1);
+    heartLobeSpan(hs.top + i,  10.0f,  tilt, w, h, b0, b1);
+    if (a0 >= a1) { a0 = b0; a1 = b1; b0 = b1 = 0; }
+    else if (b0 < b1 && b0 <= a1 && a0 <= b1) {      // overlapping or touching: merge
+      if (b0 < a0) a0 = b0;
+      if (b1 > a1) a1 = b1;
+      b0 = b1 = 0;
     }
-  };
-  drawLoveEllipse(cx - 10, cy, w, h, -t, col);
-  drawLoveEllipse(cx + 10, cy, w, h,  +t, col);
+    hs.x0[0][i] = a0; hs.x1[0][i] = a1;
+    hs.x0[1][i] = b0; hs.x1[1][i] = b1;
+  }
+  return hs;
 }
 
-// Small gradient circle (rings) for cheeks
-static inline void makeRamp(uint16_t outer, uint16_t inner, uint16_t ramp[], int rings) {
-  uint8_t ir = ((inner >> 11) & 0x1F) << 3;
-  uint8_t ig = ((inner >>  5) & 0x3F) << 2;
-  uint8_t ib = ( inner        & 0x1F) << 3;
-
-  uint8_t or_ = ((outer >> 11) & 0x1F) << 3;
-  uint8_t og  = ((outer >>  5) & 0x3F) << 2;
-  uint8_t ob  = ( outer        & 0x1F) << 3;
-
-  for (int i = 0; i < rings; ++i) {
-    float t = (float)i / (rings - 1);     // 0..1 outer->inner
-    t = t*t*(3 - 2*t);                    // ease
-    uint8_t r = or_ + (uint8_t)((ir - or_) * t);
-    uint8_t g = og  + (uint8_t)((ig - og ) * t);
-    uint8_t b = ob  + (uint8_t)((ib - ob ) * t);
-    ramp[i] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+static void drawLoveHeartShape(int cx, int cy, int w, int h, float tiltDeg, uint16_t col) {
+  const HeartSprite &hs = heartSpriteFor(w, h, tiltDeg);
+  for (int i = 0; i < hs.rows; ++i) {
+    int y = cy + hs.top + i;
+    for (int k = 0; k < 2; ++k)
+      if (hs.x0[k][i] < hs.x1[k][i])
+        canvas.drawFastHLine(cx + hs.x0[k][i], y, hs.x1[k][i] - hs.x0[k][i], col);
   }
 }
 
-static inline void drawGradientCircleFast(int cx, int cy, int r, uint16_t inner, uint16_t outer, int rings) {
-  static uint16_t ramp[16];               // CHEEK_RINGS <= 16
+// Cheek glow: CHEEK_RINGS eased rings from outer to inner colour, filled
+// in one pass. The ramp is a flash table; the squared-distance -> colour
+// table is cached per radius, so a pulse step only rebuilds that.
+static const int CHEEK_MAX_R = 48;
+static const uint16_t *gradientLut(int r, const uint16_t *ramp, int rings) {
+  static uint16_t lut[(CHEEK_MAX_R + 1) * (CHEEK_MAX_R + 1)];
+  static const uint16_t *lutRamp = nullptr;
+  static int lutR = -1;
   if (rings > 16) rings = 16;
-  makeRamp(outer, inner, ramp, rings);
-  for (int i = 0; i < rings; ++i) {
-    float t = (float)i / (rings - 1);
-    t = t*t*(3 - 2*t);
-    int rr = (int)(r * (1.0f - t) + 0.5f);   // big → small
-    if (rr <= 0) rr = 1;
-    canvas.fillCircle(cx, cy, rr, ramp[i]);
+  if (r != lutR || ramp != lutRamp) {
+    // ring i covers d2 <= rr_i^2; smaller rings sit on top
+    int32_t hi[16];
+    for (int i = 0; i < rings; ++i) {
+      float t = (float)i / (rings - 1);
+      t = t*t*(3 - 2*t);
+      int rr = (int)(r * (1.0f - t) + 0.5f);   // big → small
+      if (rr <= 0) rr = 1;
+      hi[i] = (int32_t)rr * rr;
+    }
+    for (int i = 0; i < rings; ++i) {
+      int32_t lo = (i + 1 < rings) ? hi[i + 1] + 1 : 0;
+      for (int32_t k = lo; k <= hi[i]; ++k) lut[k] = ramp[i];
+    }
+    lutR = r;
+    lutRamp = ramp;
   }
+  return lut;
+}
+
+static inline void drawGradientCircleFast(int cx, int cy, int r, const uint16_t *ramp, int rings) {
+  if (r > CHEEK_MAX_R) r = CHEEK_MAX_R;
+  canvas.fillRadial(cx, cy, r, gradientLut(r, ramp, rings));
 }
 
 static void drawCheekGlows(uint32_t now) {
-  float phase = (now * 0.001f) * (2.0f * PI * cheekHz);
-  float s = (sinf(phase) + 1.0f) * 0.5f;               // 0..1
-  int r = cheekBaseRadius + (int)((s * 2.0f - 1.0f) * cheekPulseAmp);
+  HE_q16 s = HE_sinQ16(HE_angleMs(now, cheekPeriodMs));   // -1..1
+  int r = cheekBaseRadius + (int)(s * cheekPulseAmp / HE_Q16_ONE);
   if (r < 6) r = 6;
 
   int leftCX  = centerX - eyeDistance + cheekXOffset;
   int rightCX = centerX + eyeDistance - cheekXOffset;
   int cy      = centerY + cheekYOffset;
 
-  drawGradientCircleFast(leftCX,  cy, r, cheekInnerColor, cheekOuterColor, CHEEK_RINGS);
-  drawGradientCircleFast(rightCX, cy, r, cheekInnerColor, cheekOuterColor, CHEEK_RINGS);
+  drawGradientCircleFast(leftCX,  cy, r, CHEEK_RAMP.v, CHEEK_RINGS);
+  drawGradientCircleFast(rightCX, cy, r, CHEEK_RAMP.v, CHEEK_RINGS);
 }
 
 // NEW love: draw cheeks then heart eyes (uses bobbing)
@@ -773,19 +823,21 @@ static void drawLove(unsigned long now) {
   drawCheekGlows(now);
 
   // heart eyes with subtle vertical bob
-  float offsetY = sinf(now / bobSpeedMs) * bobAmplitude;
+  int offsetY = (HE_sinQ16(HE_angleMs(now, bobPeriodMs)) * bobAmplitude) >> 16;
   drawLoveHeartShape(centerX - eyeDistance, centerY + offsetY, heartW, heartH, tiltDeg, loveColor);
   drawLoveHeartShape(centerX + eyeDistance, centerY + offsetY, heartW, heartH, tiltDeg, loveColor);
 }
 
 // === CYCLOP ===
 static void drawCyclop(unsigned long now) {
-  scalePhase += 0.03;
-  cyclopScale = 1.0 + 0.05 * sin(scalePhase);
+  constexpr uint16_t PHASE_STEP = HE_angleRad(0.03f);
+  constexpr HE_q16   SCALE_AMP  = HE_toQ16(0.05f);
+  cyclopPhase += PHASE_STEP;
+  cyclopScale = HE_Q16_ONE + HE_mulQ16(SCALE_AMP, HE_sinQ16(cyclopPhase));
 
   if (!cyclopPaused && now - lastCyclopMove > 1000) {
-    targetPX = random(-50, 51);
-    targetPY = random(-50, 51);
+    targetPX = rng(BubuRng::CYCLOP).range(-50, 51);
+    targetPY = rng(BubuRng::CYCLOP).range(-50, 51);
     lastCyclopMove = now;
     cyclopPaused = true;
   } else if (cyclopPaused && now - lastCyclopMove > 500) {
@@ -793,14 +845,15 @@ static void drawCyclop(unsigned long now) {
   }
 
   if (!cyclopPaused) {
-    pupilX += (targetPX - pupilX) * 0.1;
-    pupilY += (targetPY - pupilY) * 0.1;
+    pupilX += (targetPX * HE_Q16_ONE - pupilX) / 10;
+    pupilY += (targetPY * HE_Q16_ONE - pupilY) / 10;
   }
 
   canvas.fillScreen(GC9A01A_YELLOW);
-  int r = 100 * cyclopScale;
+  int r = (100 * cyclopScale) >> 16;
   canvas.fillCircle(centerX, centerY, r, GC9A01A_WHITE);
-  canvas.fillCircle(centerX + pupilX * cyclopScale, centerY + pupilY * cyclopScale, 30, GC9A01A_BLACK);
+  canvas.fillCircle(centerX + (HE_mulQ16(pupilX, cyclopScale) >> 16),
+                    centerY + (HE_mulQ16(pupilY, cyclopScale) >> 16), 30, GC9A01A_BLACK);
 }
 
 // === SHOCK ===
@@ -811,7 +864,7 @@ static void drawShock(unsigned long now) {
   int yOffset = 0;
 
   if (e < 3000) {
-    yOffset = sin(now / 30.0) * 10;
+    yOffset = HE_sinQ16(HE_angleMs(now, 188)) * 10 / HE_Q16_ONE;   // 30 ms per radian
     drawCircleEyes(leftX, rightX, centerY + yOffset, 35);
   } else if (e < 4000) {
     drawCircleEyes(leftX, rightX, centerY, 35);
@@ -831,8 +884,8 @@ static void drawShock(unsigned long now) {
 
 // === DRUNK ===
 static void drawDrunk(unsigned long now) {
-  phaseLeft += 0.1;
-  phaseRight -= 0.1;
+  phaseLeft  += HE_angleRad(0.1f);   // 0.1 rad per frame, wraps
+  phaseRight -= HE_angleRad(0.1f);
   drawDrunkWhirlpool(centerX - eyeDistance, centerY, 35, true, phaseLeft);
   drawDrunkWhirlpool(centerX + eyeDistance, centerY, 35, false, phaseRight);
 }
@@ -850,8 +903,8 @@ static void drawFurious(unsigned long now) {
   // eye color fade: 0..6000 ms -> 0xFFFF (white) to 0xF800 (red)
   const uint16_t startColor = 0xFFFF;
   const uint16_t endColor   = 0xF800;
-  const float    tColor     = (elapsed < 6000UL) ? (float)elapsed / 6000.0f : 1.0f;
-  const uint16_t colEye     = HE_colorLerp(startColor, endColor, tColor); // from helpers.h/.cpp
+  const HE_q16   tColor     = HE_ratioQ16(elapsed, 6000);
+  const uint16_t colEye     = HE_colorLerpQ16(startColor, endColor, tColor); // from helpers.h/.cpp
 
   // geometry (use your globals)
   const int cx = canvas.width()  / 2;
@@ -871,18 +924,16 @@ static void drawFurious(unsigned long now) {
   auto brows = [&](int lc, int rc, int y, int extent) {
     const int l_out_x = lc - (baseW/2), l_in_x  = lc + (baseW/2);
     const int r_out_x = rc + (baseW/2), r_in_x  = rc - (baseW/2);
-    for (int t = 0; t < 7; ++t) {
-      canvas.drawLine(l_out_x + 30, y - extent + t, l_in_x, y + extent + t, colEye);
-      canvas.drawLine(r_out_x - 30, y - extent + t, r_in_x, y + extent + t, colEye);
-    }
+    HE_drawThickLine(l_out_x + 30, y - extent, l_in_x, y + extent, 7, colEye);
+    HE_drawThickLine(r_out_x - 30, y - extent, r_in_x, y + extent, 7, colEye);
   };
 
   // phase 0: enter (squint + slight inward)
   if (elapsed < P0) {
-    const float t = (float)elapsed / (float)P0;
-    const int   eh  = baseH - int(t * 25.0f);
-    const int   lcx = leftCX  + int(t * 4.0f);
-    const int   rcx = rightCX - int(t * 4.0f);
+    const HE_q16 t = HE_ratioQ16(elapsed, P0);
+    const int   eh  = baseH - ((t * 25) >> 16);
+    const int   lcx = leftCX  + ((t * 4) >> 16);
+    const int   rcx = rightCX - ((t * 4) >> 16);
     eyeBox(lcx, cy, baseW, eh);
     eyeBox(rcx, cy, baseW, eh);
     return;
@@ -902,10 +953,10 @@ static void drawFurious(unsigned long now) {
   // phase 2: release
   if (elapsed < P0 + P1 + P2) {
     const unsigned long in = elapsed - (P0 + P1);
-    const float t = (float)in / (float)P2;
-    const int   eh  = (baseH - 25) + int(t * 25.0f);
-    const int   lcx = leftCX  + int((1.0f - t) * 4.0f);
-    const int   rcx = rightCX - int((1.0f - t) * 4.0f);
+    const HE_q16 t = HE_ratioQ16(in, P2);
+    const int   eh  = (baseH - 25) + ((t * 25) >> 16);
+    const int   lcx = leftCX  + (((HE_Q16_ONE - t) * 4) >> 16);
+    const int   rcx = rightCX - (((HE_Q16_ONE - t) * 4) >> 16);
     eyeBox(lcx, cy, baseW, eh);
     eyeBox(rcx, cy, baseW, eh);
     return;
@@ -956,10 +1007,8 @@ static void drawAngry(unsigned long now) {
   // 1s pulse (0→1→0) based on elapsed time of this emotion
   const uint32_t e      = now - emotionStartTime;
   const uint32_t cycle  = e % 1000;
-  const float pulse     = (cycle < 500)
-                          ? (cycle / 500.0f)
-                          : (1.0f - (cycle - 500) / 500.0f);
-  const uint8_t intensity = (uint8_t)(pulse * 255.0f);
+  const uint32_t pulse  = (cycle < 500) ? cycle : 1000 - cycle;   // 0..500
+  const uint8_t intensity = (uint8_t)(pulse * 255 / 500);
 
   // Draw eyes + pulsing red cross
   EE_drawAngryEyes();
@@ -973,20 +1022,20 @@ static uint16_t DOUBT_totalMs  = 2100;
 static uint16_t DOUBT_growMs   = 100;
 static uint16_t DOUBT_holdMs   = 1000;
 static uint16_t DOUBT_returnMs = 1000;
-static float    DOUBT_maxScale = 1.30f; // 1.20–1.40 per cycle
+static HE_q16   DOUBT_maxScale = HE_toQ16(1.30f); // 1.20–1.40 per cycle
 static int      DOUBT_distBoost = 4;    // px apart at full growth
 static EyeSide  DOUBT_side = LEFT_EYE;
 
 static void DOUBT_resetParamsAndPickSide() {
-  DOUBT_growMs   = random(80, 301);     // 80–300 ms
-  DOUBT_holdMs   = random(800, 1501);   // 0.8–1.5 s
-  DOUBT_returnMs = random(300, 701);    // 0.3–0.7 s
+  DOUBT_growMs   = rng(BubuRng::DOUBT).range(80, 301);     // 80–300 ms
+  DOUBT_holdMs   = rng(BubuRng::DOUBT).range(800, 1501);   // 0.8–1.5 s
+  DOUBT_returnMs = rng(BubuRng::DOUBT).range(300, 701);    // 0.3–0.7 s
   DOUBT_totalMs  = DOUBT_growMs + DOUBT_holdMs + DOUBT_returnMs;
 
-  DOUBT_maxScale  = 1.20f + (random(0, 21) / 100.0f); // 1.20–1.40
-  DOUBT_distBoost = random(4, 12);
+  DOUBT_maxScale  = HE_toQ16(1.20f) + rng(BubuRng::DOUBT).range(0, 21) * HE_Q16_ONE / 100; // 1.20–1.40
+  DOUBT_distBoost = rng(BubuRng::DOUBT).range(4, 12);
 
-  DOUBT_side = (random(0, 2) == 0) ? LEFT_EYE : RIGHT_EYE;
+  DOUBT_side = (rng(BubuRng::DOUBT).range(0, 2) == 0) ? LEFT_EYE : RIGHT_EYE;
 }
 
 static void drawDoubt(unsigned long now) {
@@ -1015,43 +1064,43 @@ static void drawDoubt(unsigned long now) {
   const bool scaleRight = !scaleLeft;
 
   if (e < DOUBT_growMs) {
-    float t = EE_jitteredEase((float)e / (float)DOUBT_growMs);
-    float s = 1.0f + (DOUBT_maxScale - 1.0f) * t;
-    dist  = baseD + (int)(DOUBT_distBoost * t + 0.5f);
+    HE_q16 t = HE_jitteredEaseQ16(HE_ratioQ16(e, DOUBT_growMs));
+    HE_q16 s = HE_lerpQ16(HE_Q16_ONE, DOUBT_maxScale, t);
+    dist  = baseD + HE_scaleI(DOUBT_distBoost, t);
     if (scaleLeft) {
-      Lw = (int)(baseW * s + 0.5f);
-      Lh = (int)(baseH * s + 0.5f);
-      Lr = (int)(baseR * s + 0.5f);
+      Lw = HE_scaleI(baseW, s);
+      Lh = HE_scaleI(baseH, s);
+      Lr = HE_scaleI(baseR, s);
     } else {
-      Rw = (int)(baseW * s + 0.5f);
-      Rh = (int)(baseH * s + 0.5f);
-      Rr = (int)(baseR * s + 0.5f);
+      Rw = HE_scaleI(baseW, s);
+      Rh = HE_scaleI(baseH, s);
+      Rr = HE_scaleI(baseR, s);
     }
   } else if (e < DOUBT_growMs + DOUBT_holdMs) {
-    float s = DOUBT_maxScale;
+    HE_q16 s = DOUBT_maxScale;
     dist  = baseD + DOUBT_distBoost;
     if (scaleLeft) {
-      Lw = (int)(baseW * s + 0.5f);
-      Lh = (int)(baseH * s + 0.5f);
-      Lr = (int)(baseR * s + 0.5f);
+      Lw = HE_scaleI(baseW, s);
+      Lh = HE_scaleI(baseH, s);
+      Lr = HE_scaleI(baseR, s);
     } else {
-      Rw = (int)(baseW * s + 0.5f);
-      Rh = (int)(baseH * s + 0.5f);
-      Rr = (int)(baseR * s + 0.5f);
+      Rw = HE_scaleI(baseW, s);
+      Rh = HE_scaleI(baseH, s);
+      Rr = HE_scaleI(baseR, s);
     }
   } else {
     unsigned long e2 = e - (DOUBT_growMs + DOUBT_holdMs);
-    float t = EE_jitteredEase((float)e2 / (float)DOUBT_returnMs);
-    float s = 1.0f + (DOUBT_maxScale - 1.0f) * (1.0f - t);
-    dist  = baseD + (int)(DOUBT_distBoost * (1.0f - t) + 0.5f);
+    HE_q16 t = HE_jitteredEaseQ16(HE_ratioQ16(e2, DOUBT_returnMs));
+    HE_q16 s = HE_lerpQ16(DOUBT_maxScale, HE_Q16_ONE, t);
+    dist  = baseD + HE_scaleI(DOUBT_distBoost, HE_Q16_ONE - t);
     if (scaleLeft) {
-      Lw = (int)(baseW * s + 0.5f);
-      Lh = (int)(baseH * s + 0.5f);
-      Lr = (int)(baseR * s + 0.5f);
+      Lw = HE_scaleI(baseW, s);
+      Lh = HE_scaleI(baseH, s);
+      Lr = HE_scaleI(baseR, s);
     } else {
-      Rw = (int)(baseW * s + 0.5f);
-      Rh = (int)(baseH * s + 0.5f);
-      Rr = (int)(baseR * s + 0.5f);
+      Rw = HE_scaleI(baseW, s);
+      Rh = HE_scaleI(baseH, s);
+      Rr = HE_scaleI(baseR, s);
     }
   }
 
@@ -1092,10 +1141,10 @@ static void drawAngry2(uint32_t now) {
 
   if (e < PHASE_TO_ANGRY) {
     // NORMAL -> ANGRY (with a touch of jitter on easing)
-    float t = EE_jitteredEase(e / float(PHASE_TO_ANGRY), 0.015f);
-    riseR_L = int(TOP_RISE_MAX * t + 0.5f); // left slopes down toward center
-    riseL_R = int(TOP_RISE_MAX * t + 0.5f); // right slopes down toward center
-    eyeCol  = HE_colorLerp(COL_WHITE, COL_RED, t);
+    HE_q16 t = HE_jitteredEaseQ16(HE_ratioQ16(e, PHASE_TO_ANGRY), HE_toQ16(0.015f));
+    riseR_L = HE_scaleI(TOP_RISE_MAX, t); // left slopes down toward center
+    riseL_R = HE_scaleI(TOP_RISE_MAX, t); // right slopes down toward center
+    eyeCol  = HE_colorLerpQ16(COL_WHITE, COL_RED, t);
 
   } else if (e < PHASE_TO_ANGRY + PHASE_HOLD) {
     // HOLD ANGRY
@@ -1110,42 +1159,34 @@ static void drawAngry2(uint32_t now) {
   } else {
     // ANGRY -> NORMAL
     const uint32_t e2 = e - (PHASE_TO_ANGRY + PHASE_HOLD);
-    float t = EE_jitteredEase(e2 / float(PHASE_TO_NORM), 0.015f);
-    float back = 1.0f - t;
-    riseR_L = int(TOP_RISE_MAX * back + 0.5f);
-    riseL_R = int(TOP_RISE_MAX * back + 0.5f);
-    eyeCol  = HE_colorLerp(COL_RED, COL_WHITE, t);
+    HE_q16 t = HE_jitteredEaseQ16(HE_ratioQ16(e2, PHASE_TO_NORM), HE_toQ16(0.015f));
+    HE_q16 back = HE_Q16_ONE - t;
+    riseR_L = HE_scaleI(TOP_RISE_MAX, back);
+    riseL_R = HE_scaleI(TOP_RISE_MAX, back);
+    eyeCol  = HE_colorLerpQ16(COL_RED, COL_WHITE, t);
   }
 
 
 
-  // Base rounded eyes
-  auto eyeBox = [&](int cx, int cy, int w, int h, int r, uint16_t col) {
-    canvas.fillRoundRect(cx - w/2, cy - h/2, w, h, r, col);
-  };
-
-  // Carve everything ABOVE a diagonal from (x0, y0+riseL) to (x1, y0+riseR)
-  auto carveTopDiagonal = [&](int cx, int cy, int riseL, int riseR) {
-    int x0 = cx - eyeWidth/2;
-    int x1 = cx + eyeWidth/2;
-    int y0 = cy - eyeHeight/2;
-    int yTop = y0 - 60; // far above
-    int yA = y0 + riseL;
-    int yB = y0 + riseR;
-    // Two triangles fill everything above the diagonal with background
-    canvas.fillTriangle(x0, yA, x1, yB, x0, yTop, 0x0000);
-    canvas.fillTriangle(x1, yB, x1, yTop, x0, yTop, 0x0000);
-  };
-
-  // Draw both eyes with top-carve
+  // Both eyes with the top carved away above a diagonal
   // Left eye: center-side is RIGHT → use riseR_L
-  eyeBox(leftX, centerY, eyeWidth, eyeHeight, eyeCorner, eyeCol);
-  if (riseR_L > 0) carveTopDiagonal(leftX, centerY, /*riseL*/0, /*riseR*/riseR_L);
+  HE_EyeCarve cl;
+  cl.topR = riseR_L;
+  HE_drawCarvedEye(leftX, centerY, eyeWidth, eyeHeight, eyeCorner, cl, eyeCol);
 
   // Right eye: center-side is LEFT → use riseL_R
-  eyeBox(rightX, centerY, eyeWidth, eyeHeight, eyeCorner, eyeCol);
-  if (riseL_R > 0) carveTopDiagonal(rightX, centerY, /*riseL*/riseL_R, /*riseR*/0);
+  HE_EyeCarve cr;
+  cr.topL = riseL_R;
+  HE_drawCarvedEye(rightX, centerY, eyeWidth, eyeHeight, eyeCorner, cr, eyeCol);
 }
+// Four-point sparkle masks, indexed by size (SMILE, BANH_CHUNG)
+static const BubuCanvas::SpriteMask *sparkleMasks() {
+  static BubuCanvas::SpriteMask masks[8];
+  if (!masks[1].runs)
+    for (int s = 1; s < 8; ++s) HE_spriteSparkle(masks[s], s);
+  return masks;
+}
+
 // === SMILE (carved eyes + gentle giggle + twinkling sparkles) ===
 static void drawSmile(uint32_t nowMs) {
   // ---------- Timings (ms) ----------
@@ -1161,71 +1202,40 @@ static void drawSmile(uint32_t nowMs) {
   const int carveR_end   = 60;
 
   // ---------- Giggle ----------
-  const float GIGGLE_HZ     = 4.0f;
+  const uint32_t GIGGLE_MS   = 250;   // 4 Hz (radius wobbles 1.7x faster)
   const int   GIGGLE_AMP_Y  = 4;
   const int   GIGGLE_AMP_R  = 2;
-  const float GIGGLE_PHASE_OFFSET = 0.0f;
+  const uint16_t GIGGLE_PHASE_OFFSET = 0;   // binary angle
 
   // Colors
-  const uint16_t COL_BG   = 0x0000; // black
   const uint16_t COL_EYE  = 0xFFFF; // white
   const uint16_t COL_YELL = 0xFFE0; // yellow for sparkles
 
   // ---------- Tiny helpers (local) ----------
-  auto lerpI = [](int a, int b, float t){ return a + (int)((b - a) * t + 0.5f); };
-
-  auto scale565 = [](uint16_t c, float brightness)->uint16_t {
-    if (brightness <= 0) return 0;
-    if (brightness >= 1) return c;
-    uint8_t r = ((c >> 11) & 0x1F) << 3;
-    uint8_t g = ((c >> 5)  & 0x3F) << 2;
-    uint8_t b = ( c        & 0x1F) << 3;
-    r = (uint8_t)(r * brightness);
-    g = (uint8_t)(g * brightness);
-    b = (uint8_t)(b * brightness);
-    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-  };
-
-  auto drawRoundedEye = [&](int cx, int cy, int w, int h, int r, uint16_t col){
-    canvas.fillRoundRect(cx - w/2, cy - h/2, w, h, r, col);
-  };
-  auto carveEye = [&](int cx, int cy, int yOff, int r){
-    if (r > 0) canvas.fillCircle(cx, cy + yOff, r, COL_BG);
-  };
   auto drawCarvedEye = [&](int cx, int cy, int carveYOff, int carveR){
-    drawRoundedEye(cx, cy, eyeWidth, eyeHeight, eyeCorner, COL_EYE);
-    carveEye(cx, cy, carveYOff, carveR);
-  };
-
-  auto drawSparkle4 = [&](int cx, int cy, uint16_t color, int size){
-    for (int i = 0; i < size; i++) { // vertical diamond
-      int w = size - i;
-      canvas.drawFastHLine(cx - w/2, cy - i, w, color);
-      canvas.drawFastHLine(cx - w/2, cy + i, w, color);
-    }
-    for (int i = 0; i < size; i++) { // horizontal diamond
-      int h = size - i;
-      canvas.drawFastVLine(cx - i, cy - h/2, h, color);
-      canvas.drawFastVLine(cx + i, cy - h/2, h, color);
-    }
+    HE_EyeCarve c;
+    c.circR  = carveR;                    // bite from below
+    c.circDy = carveYOff;
+    HE_drawCarvedEye(cx, cy, eyeWidth, eyeHeight, eyeCorner, c, COL_EYE);
   };
 
   struct Sparkle { int x, y, size; unsigned long offset, period; };
-  static Sparkle sparkles[7];
+  static Sparkle sparkles[8];
+  static BubuCanvas::Sprite sparkleSprites[8];
   static bool sparkleInit = false;
 
   // Re-init sparkles at the start of each SMILE play
   if (!sparkleInit || (nowMs - emotionStartTime) < 20) {
     const int leftX  = centerX - eyeDistance;
     const int rightX = centerX + eyeDistance;
-    sparkles[0] = { leftX  - 40, centerY - 60, 6, (unsigned long)random(0,1000), (unsigned long)(600 + random(0,500)) };
-    sparkles[1] = { leftX  + 50, centerY - 70, 5, (unsigned long)random(0,1000), (unsigned long)(700 + random(0,600)) };
-    sparkles[2] = { rightX + 42, centerY - 55, 7, (unsigned long)random(0,1000), (unsigned long)(800 + random(0,500)) };
-    sparkles[3] = { rightX - 52, centerY - 68, 5, (unsigned long)random(0,1000), (unsigned long)(650 + random(0,700)) };
-    sparkles[4] = { leftX  - 60, centerY + 30, 6, (unsigned long)random(0,1000), (unsigned long)(900 + random(0,600)) };
-    sparkles[5] = { rightX + 58, centerY + 28, 6, (unsigned long)random(0,1000), (unsigned long)(750 + random(0,700)) };
-    sparkles[6] = { centerX - 70,      centerY - 10, 5, (unsigned long)random(0,1000), (unsigned long)(700 + random(0,600)) };
-    sparkles[7] = { centerX + 72,      centerY - 15, 7, (unsigned long)random(0,1000), (unsigned long)(800 + random(0,700)) };
+    sparkles[0] = { leftX  - 40, centerY - 60, 6, (unsigned long)rng(BubuRng::SMILE).range(0,1000), (unsigned long)(600 + rng(BubuRng::SMILE).range(0,500)) };
+    sparkles[1] = { leftX  + 50, centerY - 70, 5, (unsigned long)rng(BubuRng::SMILE).range(0,1000), (unsigned long)(700 + rng(BubuRng::SMILE).range(0,600)) };
+    sparkles[2] = { rightX + 42, centerY - 55, 7, (unsigned long)rng(BubuRng::SMILE).range(0,1000), (unsigned long)(800 + rng(BubuRng::SMILE).range(0,500)) };
+    sparkles[3] = { rightX - 52, centerY - 68, 5, (unsigned long)rng(BubuRng::SMILE).range(0,1000), (unsigned long)(650 + rng(BubuRng::SMILE).range(0,700)) };
+    sparkles[4] = { leftX  - 60, centerY + 30, 6, (unsigned long)rng(BubuRng::SMILE).range(0,1000), (unsigned long)(900 + rng(BubuRng::SMILE).range(0,600)) };
+    sparkles[5] = { rightX + 58, centerY + 28, 6, (unsigned long)rng(BubuRng::SMILE).range(0,1000), (unsigned long)(750 + rng(BubuRng::SMILE).range(0,700)) };
+    sparkles[6] = { centerX - 70,      centerY - 10, 5, (unsigned long)rng(BubuRng::SMILE).range(0,1000), (unsigned long)(700 + rng(BubuRng::SMILE).range(0,600)) };
+    sparkles[7] = { centerX + 72,      centerY - 15, 7, (unsigned long)rng(BubuRng::SMILE).range(0,1000), (unsigned long)(800 + rng(BubuRng::SMILE).range(0,700)) };
 
     sparkleInit = true;
   }
@@ -1235,9 +1245,9 @@ static void drawSmile(uint32_t nowMs) {
 
   if (e < PHASE_TO_SMILE) {
     // NORMAL -> SMILE
-    const float t = EE_easeInOut(e / float(PHASE_TO_SMILE));
-    const int yOff = lerpI(carveY_start, carveY_end, t);
-    const int rVal = lerpI(carveR_start, carveR_end, t);
+    const HE_q16 t = HE_easeInOutQ16(HE_ratioQ16(e, PHASE_TO_SMILE));
+    const int yOff = HE_lerpI(carveY_start, carveY_end, t);
+    const int rVal = HE_lerpI(carveR_start, carveR_end, t);
     drawCarvedEye(centerX - eyeDistance, centerY, yOff, rVal);
     drawCarvedEye(centerX + eyeDistance, centerY, yOff, rVal);
 
@@ -1246,20 +1256,20 @@ static void drawSmile(uint32_t nowMs) {
     const int yBase = carveY_end;
     const int rBase = carveR_end;
 
-    const float tsec = nowMs / 1000.0f;
-    const float w    = 2.0f * PI * GIGGLE_HZ;
+    const uint16_t aY = HE_angleMs(nowMs, GIGGLE_MS);
+    const uint16_t aR = HE_angleMs(nowMs, GIGGLE_MS * 10 / 17);
 
     // Left
     {
-      int y = yBase + (int)(GIGGLE_AMP_Y * sinf(w * tsec));
-      int r = rBase + (int)(GIGGLE_AMP_R * sinf(w * tsec * 1.7f));
+      int y = yBase + GIGGLE_AMP_Y * HE_sinQ16(aY) / HE_Q16_ONE;
+      int r = rBase + GIGGLE_AMP_R * HE_sinQ16(aR) / HE_Q16_ONE;
       if (r < 1) r = 1;
       drawCarvedEye(centerX - eyeDistance, centerY, y, r);
     }
     // Right (phase shifted)
     {
-      int y = yBase + (int)(GIGGLE_AMP_Y * sinf(w * tsec + GIGGLE_PHASE_OFFSET));
-      int r = rBase + (int)(GIGGLE_AMP_R * sinf(w * tsec * 1.7f + GIGGLE_PHASE_OFFSET));
+      int y = yBase + GIGGLE_AMP_Y * HE_sinQ16(aY + GIGGLE_PHASE_OFFSET) / HE_Q16_ONE;
+      int r = rBase + GIGGLE_AMP_R * HE_sinQ16(aR + GIGGLE_PHASE_OFFSET) / HE_Q16_ONE;
       if (r < 1) r = 1;
       drawCarvedEye(centerX + eyeDistance, centerY, y, r);
     }
@@ -1267,21 +1277,20 @@ static void drawSmile(uint32_t nowMs) {
   } else {
     // SMILE -> NORMAL
     const uint32_t e2 = e - (PHASE_TO_SMILE + PHASE_HOLD);
-    const float t = EE_easeInOut(e2 / float(PHASE_TO_NORM));
-    const int yOff = lerpI(carveY_end,   carveY_start, t);
-    const int rVal = lerpI(carveR_end,   carveR_start, t);
+    const HE_q16 t = HE_easeInOutQ16(HE_ratioQ16(e2, PHASE_TO_NORM));
+    const int yOff = HE_lerpI(carveY_end,   carveY_start, t);
+    const int rVal = HE_lerpI(carveR_end,   carveR_start, t);
     drawCarvedEye(centerX - eyeDistance, centerY, yOff, rVal);
     drawCarvedEye(centerX + eyeDistance, centerY, yOff, rVal);
   }
 
   // ---------- Twinkling sparkles on top ----------
   for (int i = 0; i < 6; ++i) {
-    const unsigned long T = sparkles[i].period;
-    const unsigned long tlocal = (nowMs + sparkles[i].offset) % T;
-    const float phase = tlocal / float(T); // 0..1
-    const float fade = 0.5f * (1.0f - cosf(2.0f * PI * phase)); // 0→1→0
-    drawSparkle4(sparkles[i].x, sparkles[i].y, scale565(COL_YELL, fade), sparkles[i].size);
+    const HE_q16 fade = HE_pulseQ16(HE_angleMs(nowMs + sparkles[i].offset, sparkles[i].period)); // 0→1→0
+    sparkleSprites[i] = { (int16_t)sparkles[i].x, (int16_t)sparkles[i].y,
+                          BubuCanvas::dim565(COL_YELL, (uint8_t)HE_scaleI(255, fade)), (uint8_t)sparkles[i].size };
   }
+  canvas.stampBatch(sparkleMasks(), sparkleSprites, 6);
 }
 // === BANH_CHUNG (leaf-wrapped cake eyes + thin double ribbons + random sparkles) ===
 static void drawBanhChung(uint32_t nowMs){
@@ -1302,25 +1311,6 @@ static void drawBanhChung(uint32_t nowMs){
   const int Ey = centerY;
 
   // —— helpers (local, no collisions) ——
-  auto clamp01 = [](float v){ return v<0?0:(v>1?1:v); };
-  auto easeInOut = [&](float t){
-    t = clamp01(t);
-    return (t < 0.5f) ? (2.0f*t*t) : (-1.0f + (4.0f - 2.0f*t)*t);
-  };
-  auto colorLerp565 = [&](uint16_t c1, uint16_t c2, float t){
-    t = clamp01(t);
-    uint8_t r1=((c1>>11)&0x1F), g1=((c1>>5)&0x3F), b1=(c1&0x1F);
-    uint8_t r2=((c2>>11)&0x1F), g2=((c2>>5)&0x3F), b2=(c2&0x1F);
-    uint8_t r=r1+(int)((r2-r1)*t+0.5f), g=g1+(int)((g2-g1)*t+0.5f), b=b1+(int)((b2-b1)*t+0.5f);
-    return (uint16_t)((r<<11)|(g<<5)|b);
-  };
-  auto scale565 = [&](uint16_t c, float b){
-    if (b <= 0) return (uint16_t)0;
-    if (b >= 1) return c;
-    uint8_t r = ((c>>11)&0x1F)<<3, g=((c>>5)&0x3F)<<2, bl=(c&0x1F)<<3;
-    r=(uint8_t)(r*b); g=(uint8_t)(g*b); bl=(uint8_t)(bl*b);
-    return (uint16_t)(((r&0xF8)<<8)|((g&0xFC)<<3)|(bl>>3));
-  };
   auto fillEyeBox = [&](int cx,int cy,int w,int h,int r,uint16_t col){
     canvas.fillRoundRect(cx - w/2, cy - h/2, w, h, r, col);
   };
@@ -1332,34 +1322,23 @@ static void drawBanhChung(uint32_t nowMs){
     canvas.fillRect(cx - w/2, cy - gap/2 - band/2, w, band, RIBBON);
     canvas.fillRect(cx - w/2, cy + gap/2 - band/2, w, band, RIBBON);
   };
-  auto drawSparkle4 = [&](int cx, int cy, uint16_t color, int size){
-    for (int i = 0; i < size; i++) {
-      int w = size - i;
-      canvas.drawFastHLine(cx - w/2, cy - i, w, color);
-      canvas.drawFastHLine(cx - w/2, cy + i, w, color);
-    }
-    for (int i = 0; i < size; i++) {
-      int h = size - i;
-      canvas.drawFastVLine(cx - i, cy - h/2, h, color);
-      canvas.drawFastVLine(cx + i, cy - h/2, h, color);
-    }
-  };
 
   // —— sparkle state (random across screen, reshuffle once per cycle) ——
   struct Sparkle { int x, y, size; unsigned long offset, period; };
   static const int NUM_SPARKLES = 10;
   static Sparkle sparkles[NUM_SPARKLES];
+  static BubuCanvas::Sprite sparkleSprites[NUM_SPARKLES];
   static uint32_t last_cycle_id = 0xFFFFFFFF;
 
   auto initSparklesForCycle = [&](uint32_t cycle_id){
     for (int i = 0; i < NUM_SPARKLES; i++) {
-      int s = random(4, 8);
+      int s = rng(BubuRng::BANH_CHUNG).range(4, 8);
       int margin = s + 2;
-      sparkles[i].x = random(margin, 240 - margin);
-      sparkles[i].y = random(margin, 240 - margin);
+      sparkles[i].x = rng(BubuRng::BANH_CHUNG).range(margin, 240 - margin);
+      sparkles[i].y = rng(BubuRng::BANH_CHUNG).range(margin, 240 - margin);
       sparkles[i].size = s;
-      sparkles[i].offset = (unsigned long)random(0, 1000);
-      sparkles[i].period = (unsigned long)(600 + random(0, 700)); // 600..1299 ms
+      sparkles[i].offset = (unsigned long)rng(BubuRng::BANH_CHUNG).range(0, 1000);
+      sparkles[i].period = (unsigned long)(600 + rng(BubuRng::BANH_CHUNG).range(0, 700)); // 600..1299 ms
     }
     last_cycle_id = cycle_id;
   };
@@ -1369,45 +1348,43 @@ static void drawBanhChung(uint32_t nowMs){
   const uint32_t cycle_id = nowMs / TOTAL_MS;
   if (cycle_id != last_cycle_id) initSparklesForCycle(cycle_id);
 
-  float tIn=0.f, tOut=0.f;
-  if (e < PHASE_IN) tIn = easeInOut(e / float(PHASE_IN));
-  else if (e < PHASE_IN + PHASE_HOLD) tIn = 1.f;
-  else { uint32_t e2 = e - (PHASE_IN + PHASE_HOLD); tOut = easeInOut(e2 / float(PHASE_OUT)); }
-  float tMorph = (tIn > 0.f) ? tIn : (1.f - tOut);
+  HE_q16 tIn = 0, tOut = 0;
+  if (e < PHASE_IN) tIn = HE_easeInOutQ16(HE_ratioQ16(e, PHASE_IN));
+  else if (e < PHASE_IN + PHASE_HOLD) tIn = HE_Q16_ONE;
+  else { uint32_t e2 = e - (PHASE_IN + PHASE_HOLD); tOut = HE_easeInOutQ16(HE_ratioQ16(e2, PHASE_OUT)); }
+  HE_q16 tMorph = (tIn > 0) ? tIn : (HE_Q16_ONE - tOut);
 
   // morph: normal eye → cake
   const int w0 = eyeWidth,  h0 = eyeHeight, r0 = eyeCorner;
   const int w1 = eyeWidth + 6, h1 = eyeHeight + 6, r1 = 8;
-  const int wM = w0 + (int)((w1 - w0) * tMorph + 0.5f);
-  const int hM = h0 + (int)((h1 - h0) * tMorph + 0.5f);
-  const int rM = r0 + (int)((r1 - r0) * tMorph + 0.5f);
-  const uint16_t colEye = colorLerp565(COL_WHITE, LEAF_MID, tMorph);
+  const int wM = HE_lerpI(w0, w1, tMorph);
+  const int hM = HE_lerpI(h0, h1, tMorph);
+  const int rM = HE_lerpI(r0, r1, tMorph);
+  const uint16_t colEye = HE_colorLerpQ16(COL_WHITE, LEAF_MID, tMorph);
 
   // gentle bounce during hold
   int bounceY = 0;
-  if (tIn == 1.f && tOut == 0.f) {
-    float tsec = nowMs / 1000.0f;
-    bounceY = (int)(2.0f * sinf(2.0f * PI * 2.2f * tsec));
+  if (tIn == HE_Q16_ONE && tOut == 0) {
+    bounceY = 2 * HE_sinQ16(HE_angleMs(nowMs, 455)) / HE_Q16_ONE;   // 2.2 Hz
   }
 
   // draw frame
 
 
   fillEyeBox(Lx, Ey + bounceY, wM, hM, rM, colEye);
-  if (tMorph > 0.15f) drawRibbonRect(Lx, Ey + bounceY, wM, hM);
+  if (tMorph > HE_toQ16(0.15f)) drawRibbonRect(Lx, Ey + bounceY, wM, hM);
 
   fillEyeBox(Rx, Ey - bounceY, wM, hM, rM, colEye);
-  if (tMorph > 0.15f) drawRibbonRect(Rx, Ey - bounceY, wM, hM);
+  if (tMorph > HE_toQ16(0.15f)) drawRibbonRect(Rx, Ey - bounceY, wM, hM);
 
   // twinkling sparkles only during hold
-  if (tIn == 1.f && tOut == 0.f) {
+  if (tIn == HE_Q16_ONE && tOut == 0) {
     for (int i = 0; i < NUM_SPARKLES; ++i) {
-      const unsigned long T  = sparkles[i].period;
-      const unsigned long tl = (nowMs + sparkles[i].offset) % T;
-      const float phase = tl / float(T);
-      const float fade  = 0.5f * (1.f - cosf(2.f * PI * phase));
-      drawSparkle4(sparkles[i].x, sparkles[i].y, scale565(GLINT, fade), sparkles[i].size);
+      const HE_q16 fade = HE_pulseQ16(HE_angleMs(nowMs + sparkles[i].offset, sparkles[i].period));
+      sparkleSprites[i] = { (int16_t)sparkles[i].x, (int16_t)sparkles[i].y,
+                            BubuCanvas::dim565(GLINT, (uint8_t)HE_scaleI(255, fade)), (uint8_t)sparkles[i].size };
     }
+    canvas.stampBatch(sparkleMasks(), sparkleSprites, NUM_SPARKLES);
   }
 }
 // ===================== DEADPOOL (ring -> eyes -> brow -> dots -> divider) =====================
@@ -1444,14 +1421,16 @@ namespace {
 
   // Dots (spawn on HOLD; clear on IN)
   const int   DP_DOTS_COUNT   = 240;
-  const float DP_DOT_R_MIN    = 1.5f;
-  const float DP_DOT_R_MAX    = 5.0f;
-  const float DP_BIAS_X       = 3.0f;   // stronger density toward right
-  const float DP_BIAS_Y       = 3.0f;   // stronger density toward bottom
-  const float DP_ACCEPT_GAMMA = 0.5f;   // thinner toward top-left
-
-  struct DPDot { int x, y, r; };
-  static DPDot dpDots[DP_DOTS_COUNT];
+  const HE_q16 DP_DOT_R_MIN   = HE_toQ16(1.5f);
+  const HE_q16 DP_DOT_R_MAX   = HE_toQ16(5.0f);
+  const int   DP_BIAS_X       = 3;      // stronger density toward right
+  const int   DP_BIAS_Y       = 3;      // stronger density toward bottom
+                                        // accept with sqrt(x*y)/240: thinner toward top-left
+
+  // one stamp per dot, mask = radius (disc masks 0..DP_DOT_MASKS-1)
+  const int   DP_DOT_MASKS    = 6;
+  static BubuCanvas::Sprite     dpDots[DP_DOTS_COUNT];
+  static BubuCanvas::SpriteMask dpDotMasks[DP_DOT_MASKS];
   static int   dpDotsPlaced = 0;
   static bool  dpDotsActive = false;
 
@@ -1459,27 +1438,26 @@ namespace {
   static DPPhase dpPrevPhase = DP_OUT; // start such that first IN clears
 
   // helpers
-  inline float dpFrand() { return (float)random(0, 10000) / 10000.0f; }
-  inline float dpRandBiasedHigh(float k) {
-    float r = dpFrand();
-    return 1.0f - powf(r, k); // bias toward 1.0
-  }
-  inline float dpEaseInOut(float x){
-    if (x <= 0) return 0; if (x >= 1) return 1;
-    return (x < 0.5f) ? (2.0f*x*x) : (-1.0f + (4.0f - 2.0f*x)*x);
+  inline HE_q16 dpFrand() { return (HE_q16)(rng(BubuRng::DEADPOOL).next() >> 16); }   // 0..1, Q16
+  inline HE_q16 dpRandBiasedHigh(int k) {
+    HE_q16 r = dpFrand(), p = HE_Q16_ONE;
+    while (k-- > 0) p = HE_mulQ16(p, r);
+    return HE_Q16_ONE - p; // bias toward 1.0
   }
 
   bool dpSampleDot(int &xOut, int &yOut, int &rOut) {
-    float ux = dpRandBiasedHigh(DP_BIAS_X);
-    float uy = dpRandBiasedHigh(DP_BIAS_Y);
-    int   x  = (int)(ux * (240 - 1) + 0.5f);
-    int   y  = (int)(uy * (240 - 1) + 0.5f);
-
-    float p = powf((x / (float)240) * (y / (float)240), DP_ACCEPT_GAMMA);
-    if (dpFrand() > p) return false;
-
-    float rr = DP_DOT_R_MIN + (DP_DOT_R_MAX - DP_DOT_R_MIN) * dpFrand();
-    int r = (int)(rr + 0.5f); if (r < 1) r = 1;
+    HE_q16 ux = dpRandBiasedHigh(DP_BIAS_X);
+    HE_q16 uy = dpRandBiasedHigh(DP_BIAS_Y);
+    int   x  = HE_scaleI(240 - 1, ux);
+    int   y  = HE_scaleI(240 - 1, uy);
+
+    // rand > sqrt(x*y / 240^2)  <=>  rand^2 > x*y / 240^2
+    const uint32_t p2 = ((uint32_t)(x * y) << 16) / (240u * 240u);
+    HE_q16 u = dpFrand();
+    if ((uint32_t)HE_mulQ16(u, u) > p2) return false;
+
+    HE_q16 rr = HE_lerpQ16(DP_DOT_R_MIN, DP_DOT_R_MAX, dpFrand());
+    int r = (rr + HE_Q16_HALF) >> 16; if (r < 1) r = 1;
     xOut = x; yOut = y; rOut = r;
     return true;
   }
@@ -1492,7 +1470,7 @@ namespace {
       ++tries;
       int x, y, r;
       if (!dpSampleDot(x, y, r)) continue;
-      dpDots[dpDotsPlaced++] = {x, y, r};
+      dpDots[dpDotsPlaced++] = { (int16_t)x, (int16_t)y, DP_COL_RED, (uint8_t)r };
     }
     dpDotsActive = true;
   }
@@ -1502,9 +1480,8 @@ namespace {
   // drawing
   inline void dpDrawRing() {
     int innerR = DP_OUTER_R - DP_RING_THICK; if (innerR < 0) innerR = 0;
-    // base is already blanked by engine; draw ring
-    canvas.fillCircle(centerX, centerY, DP_OUTER_R, DP_COL_RED);
-    canvas.fillCircle(centerX, centerY, innerR, DP_COL_BG);
+    // base is already blanked by engine; draw only the ring
+    canvas.fillAnnulus(centerX, centerY, innerR, DP_OUTER_R, DP_COL_RED);
   }
   inline void dpDrawEyes() {
     int leftX  = centerX - DP_EYE_SPACING;
@@ -1520,10 +1497,9 @@ namespace {
   }
   inline void dpDrawDots() {
     if (!dpDotsActive || dpDotsPlaced <= 0) return;
-    for (int i = 0; i < dpDotsPlaced; ++i) {
-      const DPDot &d = dpDots[i];
-      canvas.fillCircle(d.x, d.y, d.r, DP_COL_RED);
-    }
+    if (!dpDotMasks[1].runs)
+      for (int r = 0; r < DP_DOT_MASKS; ++r) HE_spriteDisc(dpDotMasks[r], r);
+    canvas.stampBatch(dpDotMasks, dpDots, dpDotsPlaced);
   }
   inline void dpDrawDivider() {
     int x0 = centerX - DP_DIVIDER_W/2;
@@ -1541,16 +1517,16 @@ static void drawDEADPOOL(uint32_t now) {
   int yOff = 0;
   if (elapsed < DP_PHASE_IN_MS) {
     curPhase = DP_IN;
-    float t = (DP_PHASE_IN_MS == 0) ? 1.f : (elapsed / float(DP_PHASE_IN_MS));
-    yOff = int(dpEaseInOut(t) * DP_MOVE_AMPL_PX + 0.5f);
+    HE_q16 t = HE_ratioQ16(elapsed, DP_PHASE_IN_MS);
+    yOff = HE_scaleI(DP_MOVE_AMPL_PX, HE_easeInOutQ16(t));
   } else if (elapsed < DP_PHASE_IN_MS + DP_PHASE_HOLD_MS) {
     curPhase = DP_HOLD;
     yOff = DP_MOVE_AMPL_PX;
   } else {
     curPhase = DP_OUT;
     uint32_t e2 = elapsed - (DP_PHASE_IN_MS + DP_PHASE_HOLD_MS);
-    float t = (DP_PHASE_OUT_MS == 0) ? 1.f : (e2 / float(DP_PHASE_OUT_MS));
-    yOff = int((1.0f - dpEaseInOut(t)) * DP_MOVE_AMPL_PX + 0.5f);
+    HE_q16 t = HE_ratioQ16(e2, DP_PHASE_OUT_MS);
+    yOff = HE_scaleI(DP_MOVE_AMPL_PX, HE_Q16_ONE - HE_easeInOutQ16(t));
   }
 
   // Phase transitions: spawn/clear dots
@@ -1586,18 +1562,18 @@ void drawCARVE_SESSION(unsigned long now) {
     int eyeCorner = 20;
 
     // Wander & blink (blink only in NORMAL; disabled during EMO)
-    float wanderX = 0, wanderY = 0;
-    float targetX = 0, targetY = 0;
+    HE_q16 wanderX = 0, wanderY = 0;      // Q16 pixels
+    HE_q16 targetX = 0, targetY = 0;
     unsigned long lastMoveTime = 0;
     int   moveInterval = 1000;
-    float easing = 0.10f;
+    HE_q16 easing = HE_toQ16(0.10f);
 
     enum BlinkState { BLINK_IDLE, BLINK_CLOSING, BLINK_CLOSED, BLINK_OPENING };
     BlinkState blinkState = BLINK_IDLE;
     unsigned long blinkStart = 0;
     int           blinkDuration = 150;
     unsigned long nextBlinkTime = 0;
-    float         blinkProgress = 0.0f;
+    HE_q16        blinkProgress = 0;
 
     // Phase machine
     enum Phase : uint8_t { PH_NORMAL_IDLE=0, PH_NORMAL_RECENTER, PH_PLAY_EMO, PH_RETURN_TO_NORMAL, PH_DONE };
@@ -1618,53 +1594,27 @@ void drawCARVE_SESSION(unsigned long now) {
   } static S;
 
   // --- Tiny helpers (local) ---
-  auto easeInOut = [](float t)->float {
-    if (t<=0) return 0; if (t>=1) return 1;
-    return (t<0.5f) ? (2*t*t) : (-1 + (4 - 2*t)*t);
-  };
-
   auto eyeBox = [](int cx, int cy, int w, int h, int r, uint16_t col){
     canvas.fillRoundRect(cx - w/2, cy - h/2, w, h, r, col);
   };
 
-  auto carveTopDiagonal = [&](int cx, int cy, int riseL, int riseR, uint16_t bg=GC9A01A_BLACK) {
-    const int x0  = cx - S.eyeWidth/2;
-    const int x1  = cx + S.eyeWidth/2;
-    const int y0  = cy - S.eyeHeight/2;
-    const int yTop= y0 - 60;
-    const int yA  = y0 + riseL;  // LEFT edge height
-    const int yB  = y0 + riseR;  // RIGHT edge height
-    canvas.fillTriangle(x0, yA, x1, yB, x0, yTop, bg);
-    canvas.fillTriangle(x1, yB, x1, yTop, x0, yTop, bg);
-  };
-
-  auto carveBottomDiagonal = [&](int cx, int cy, int dropL, int dropR, uint16_t bg=GC9A01A_BLACK) {
-    const int x0  = cx - S.eyeWidth/2;
-    const int x1  = cx + S.eyeWidth/2;
-    const int y1  = cy + S.eyeHeight/2;
-    const int yBot= y1 + 60;
-    const int yA  = y1 - dropL;  // LEFT edge height
-    const int yB  = y1 - dropR;  // RIGHT edge height
-    canvas.fillTriangle(x0, yA, x1, yB, x0, yBot, bg);
-    canvas.fillTriangle(x1, yB, x1, yBot, x0, yBot, bg);
-  };
-
-  auto carveEyeCorner = [&](int cx, int cy, bool isLeftEye, bool topNotBottom, int depthInner, int depthOuter, uint16_t bg=GC9A01A_BLACK) {
+  // Diagonal cut along the top or bottom edge, depths given inner/outer
+  auto carveEyeCorner = [](HE_EyeCarve &c, bool isLeftEye, bool topNotBottom, int depthInner, int depthOuter) {
     const bool innerIsLeft = !isLeftEye;
     const int leftDepth  = innerIsLeft ? depthInner : depthOuter;
     const int rightDepth = innerIsLeft ? depthOuter : depthInner;
-    if (topNotBottom) carveTopDiagonal(cx,  cy, leftDepth,  rightDepth,  bg);
-    else              carveBottomDiagonal(cx, cy, leftDepth, rightDepth, bg);
+    if (topNotBottom) { c.topL = leftDepth; c.topR = rightDepth; }
+    else              { c.botL = leftDepth; c.botR = rightDepth; }
   };
 
   auto updateWander = [&](uint32_t now){
     if (now - S.lastMoveTime > (uint32_t)S.moveInterval) {
-      S.targetX = random(-20, 21);
-      S.targetY = random(-20, 21);
+      S.targetX = rng(BubuRng::CARVE).range(-20, 21) * HE_Q16_ONE;
+      S.targetY = rng(BubuRng::CARVE).range(-20, 21) * HE_Q16_ONE;
       S.lastMoveTime = now;
     }
-    S.wanderX += (S.targetX - S.wanderX) * S.easing;
-    S.wanderY += (S.targetY - S.wanderY) * S.easing;
+    S.wanderX += HE_mulQ16(S.targetX - S.wanderX, S.easing);
+    S.wanderY += HE_mulQ16(S.targetY - S.wanderY, S.easing);
   };
 
   auto updateBlink = [&](uint32_t now){
@@ -1674,53 +1624,44 @@ void drawCARVE_SESSION(unsigned long now) {
         if (now > S.nextBlinkTime) { S.blinkState = BS::BLINK_CLOSING; S.blinkStart = now; }
         break;
       case BS::BLINK_CLOSING: {
-        float t = float(now - S.blinkStart) / S.blinkDuration;
-        S.blinkProgress = (t >= 1.0f) ? 1.0f : t;
-        if (S.blinkProgress >= 1.0f) { S.blinkState = BS::BLINK_CLOSED; S.blinkStart = now; }
+        S.blinkProgress = HE_ratioQ16(now - S.blinkStart, S.blinkDuration);
+        if (S.blinkProgress >= HE_Q16_ONE) { S.blinkState = BS::BLINK_CLOSED; S.blinkStart = now; }
       } break;
       case BS::BLINK_CLOSED:
         if (now - S.blinkStart > 100) { S.blinkState = BS::BLINK_OPENING; S.blinkStart = now; }
         break;
       case BS::BLINK_OPENING: {
-        float t = float(now - S.blinkStart) / S.blinkDuration;
-        S.blinkProgress = 1.0f - ((t >= 1.0f) ? 1.0f : t);
-        if (S.blinkProgress <= 0.0f) { S.blinkProgress = 0.0f; S.blinkState = BS::BLINK_IDLE; S.nextBlinkTime = now + random(1000, 3000); }
+        S.blinkProgress = HE_Q16_ONE - HE_ratioQ16(now - S.blinkStart, S.blinkDuration);
+        if (S.blinkProgress <= 0) { S.blinkState = BS::BLINK_IDLE; S.nextBlinkTime = now + rng(BubuRng::CARVE).range(1000, 3000); }
       } break;
     }
   };
 
   auto drawNormalEyesWithBlink = [&](int cxOverride = INT32_MIN, int cyOverride = INT32_MIN){
     int hOpen = S.eyeHeight;
-    int h = (int)(hOpen * (1.0f - 0.75f * S.blinkProgress)); // 0→1 closes ~75%
+    int h = HE_scaleI(hOpen, HE_Q16_ONE - HE_mulQ16(HE_toQ16(0.75f), S.blinkProgress)); // 0→1 closes ~75%
     if (h < 4) h = 4;
 
-    const int leftX  = (cxOverride==INT32_MIN) ? S.centerX - S.eyeDistance + (int)roundf(S.wanderX) : cxOverride - S.eyeDistance;
-    const int rightX = (cxOverride==INT32_MIN) ? S.centerX + S.eyeDistance + (int)roundf(S.wanderX) : cxOverride + S.eyeDistance;
-    const int cy     = (cyOverride==INT32_MIN) ? S.centerY + (int)roundf(S.wanderY) : cyOverride;
+    const int leftX  = (cxOverride==INT32_MIN) ? S.centerX - S.eyeDistance + HE_roundQ16(S.wanderX) : cxOverride - S.eyeDistance;
+    const int rightX = (cxOverride==INT32_MIN) ? S.centerX + S.eyeDistance + HE_roundQ16(S.wanderX) : cxOverride + S.eyeDistance;
+    const int cy     = (cyOverride==INT32_MIN) ? S.centerY + HE_roundQ16(S.wanderY) : cyOverride;
 
     eyeBox(leftX,  cy, S.eyeWidth, h, S.eyeCorner, GC9A01A_WHITE);
     eyeBox(rightX, cy, S.eyeWidth, h, S.eyeCorner, GC9A01A_WHITE);
   };
 
-  auto drawBaseEyesNoBlink = [&](){
-    const int leftX  = S.centerX - S.eyeDistance + (int)roundf(S.wanderX);
-    const int rightX = S.centerX + S.eyeDistance + (int)roundf(S.wanderX);
-    const int cy     = S.centerY + (int)roundf(S.wanderY);
-    eyeBox(leftX,  cy, S.eyeWidth, S.eyeHeight, S.eyeCorner, GC9A01A_WHITE);
-    eyeBox(rightX, cy, S.eyeWidth, S.eyeHeight, S.eyeCorner, GC9A01A_WHITE);
-  };
 
   auto startNormal = [&](uint32_t now){
     S.phase = decltype(S)::PH_NORMAL_IDLE;
     S.phaseStart = now;
-    S.normalIdleTargetMs = random(3000, 8001); // 3–8 s
+    S.normalIdleTargetMs = rng(BubuRng::CARVE).range(3000, 8001); // 3–8 s
   };
 
   auto startEmotion = [&](uint32_t now){
     S.phase = decltype(S)::PH_PLAY_EMO;
     S.phaseStart = now;
-    S.modeThisCycle = (decltype(S)::Mode)random(0,4); // 0..3
-    S.suspiciousLeft = (random(0,2) == 0);
+    S.modeThisCycle = (decltype(S)::Mode)rng(BubuRng::CARVE).range(0,4); // 0..3
+    S.suspiciousLeft = (rng(BubuRng::CARVE).range(0,2) == 0);
   };
 
   // --- One-time init when the emotion starts ---
@@ -1729,11 +1670,11 @@ void drawCARVE_SESSION(unsigned long now) {
     g_carveSessionDone = false;   // reset the global "done" flag
     firstFrame = false;  
     // Seed blink timing and wander
-    S.nextBlinkTime = now + random(1000, 3000);
+    S.nextBlinkTime = now + rng(BubuRng::CARVE).range(1000, 3000);
     S.lastMoveTime  = now;
     // Random session length 30–60 s, anchored to emotionStartTime (global)
     extern unsigned long emotionStartTime;
-    S.sessionStopAt = emotionStartTime + random(50000, 60001);
+    S.sessionStopAt = emotionStartTime + rng(BubuRng::CARVE).range(50000, 60001);
     S.sessionActive = true;
     // Start in normal idle
     startNormal(now);
@@ -1760,13 +1701,13 @@ void drawCARVE_SESSION(unsigned long now) {
     } break;
 
     case decltype(S)::PH_NORMAL_RECENTER: {
-      S.wanderX *= 0.80f;
-      S.wanderY *= 0.80f;
+      S.wanderX = HE_mulQ16(S.wanderX, HE_toQ16(0.80f));
+      S.wanderY = HE_mulQ16(S.wanderY, HE_toQ16(0.80f));
       updateBlink(now);
       drawNormalEyesWithBlink();
 
-      if (fabsf(S.wanderX) < 1.0f && fabsf(S.wanderY) < 1.0f) {
-        S.wanderX = S.wanderY = 0.0f;
+      if (abs(S.wanderX) < HE_Q16_ONE && abs(S.wanderY) < HE_Q16_ONE) {
+        S.wanderX = S.wanderY = 0;
         if (S.sessionActive && now < S.sessionStopAt) {
           startEmotion(now);
         } else {
@@ -1780,50 +1721,52 @@ void drawCARVE_SESSION(unsigned long now) {
 
     case decltype(S)::PH_PLAY_EMO: {
       updateWander(now);
-      drawBaseEyesNoBlink();
 
       uint32_t e = now - S.phaseStart;
       if (e > CARVE_EMO_TOTAL) e = CARVE_EMO_TOTAL;
-      float t;
-      if (e < CARVE_EASE_IN)                          t = easeInOut(float(e) / CARVE_EASE_IN);
-      else if (e < CARVE_EASE_IN + CARVE_HOLD)        t = 1.0f;
-      else                                            t = 1.0f - easeInOut(float(e - (CARVE_EASE_IN + CARVE_HOLD)) / CARVE_EASE_OUT);
+      HE_q16 t;
+      if (e < CARVE_EASE_IN)                          t = HE_easeInOutQ16(HE_ratioQ16(e, CARVE_EASE_IN));
+      else if (e < CARVE_EASE_IN + CARVE_HOLD)        t = HE_Q16_ONE;
+      else                                            t = HE_Q16_ONE - HE_easeInOutQ16(HE_ratioQ16(e - (CARVE_EASE_IN + CARVE_HOLD), CARVE_EASE_OUT));
 
-      if (t > 0.f) {
-        const int leftX  = S.centerX - S.eyeDistance + (int)roundf(S.wanderX);
-        const int rightX = S.centerX + S.eyeDistance + (int)roundf(S.wanderX);
-        const int cy     = S.centerY + (int)roundf(S.wanderY);
+      const int leftX  = S.centerX - S.eyeDistance + HE_roundQ16(S.wanderX);
+      const int rightX = S.centerX + S.eyeDistance + HE_roundQ16(S.wanderX);
+      const int cy     = S.centerY + HE_roundQ16(S.wanderY);
+      HE_EyeCarve cl, cr;
 
+      if (t > 0) {
         if (S.modeThisCycle == decltype(S)::MODE_SUSPICIOUS) {
-          const int rise = int(22 * t + 0.5f);
+          const int rise = HE_scaleI(22, t);
           if (S.suspiciousLeft) {
-            carveEyeCorner(leftX,  cy, /*isLeftEye=*/true,  /*top*/true, /*inner*/rise, /*outer*/0);
+            carveEyeCorner(cl, /*isLeftEye=*/true,  /*top*/true, /*inner*/rise, /*outer*/0);
           } else {
-            carveEyeCorner(rightX, cy, /*isLeftEye=*/false, /*top*/true, /*inner*/rise, /*outer*/0);
+            carveEyeCorner(cr, /*isLeftEye=*/false, /*top*/true, /*inner*/rise, /*outer*/0);
           }
 
         } else if (S.modeThisCycle == decltype(S)::MODE_HAPPY) {
-          const int dropO = int(28 * t + 0.5f); // outside deeper
-          const int dropI = int( 8 * t + 0.5f); // inside shallow
-          carveEyeCorner(leftX,  cy, true,  /*bottom*/false, /*inner*/dropI, /*outer*/dropO);
-          carveEyeCorner(rightX, cy, false, /*bottom*/false, /*inner*/dropI, /*outer*/dropO);
+          const int dropO = HE_scaleI(28, t); // outside deeper
+          const int dropI = HE_scaleI( 8, t); // inside shallow
+          carveEyeCorner(cl, true,  /*bottom*/false, /*inner*/dropI, /*outer*/dropO);
+          carveEyeCorner(cr, false, /*bottom*/false, /*inner*/dropI, /*outer*/dropO);
 
         } else if (S.modeThisCycle == decltype(S)::MODE_TOPCUT) {
-          const int riseO = int(26 * t + 0.5f);
-          const int riseI = int( 6 * t + 0.5f);
-          carveEyeCorner(leftX,  cy, true,  /*top*/true, /*inner*/riseI, /*outer*/riseO);
-          carveEyeCorner(rightX, cy, false, /*top*/true, /*inner*/riseI, /*outer*/riseO);
+          const int riseO = HE_scaleI(26, t);
+          const int riseI = HE_scaleI( 6, t);
+          carveEyeCorner(cl, true,  /*top*/true, /*inner*/riseI, /*outer*/riseO);
+          carveEyeCorner(cr, false, /*top*/true, /*inner*/riseI, /*outer*/riseO);
 
         } else { // MODE_WORRY (single eye, top outer chamfer)
-          const int riseO = int(26 * t + 0.5f);
-          const int riseI = int( 6 * t + 0.5f);
+          const int riseO = HE_scaleI(26, t);
+          const int riseI = HE_scaleI( 6, t);
           if (S.suspiciousLeft) {
-            carveEyeCorner(leftX,  cy, true,  /*top*/true,  /*inner*/riseI, /*outer*/riseO);
+            carveEyeCorner(cl, true,  /*top*/true,  /*inner*/riseI, /*outer*/riseO);
           } else {
-            carveEyeCorner(rightX, cy, false, /*top*/true,  /*inner*/riseI, /*outer*/riseO);
+            carveEyeCorner(cr, false, /*top*/true,  /*inner*/riseI, /*outer*/riseO);
           }
         }
       }
+      HE_drawCarvedEye(leftX,  cy, S.eyeWidth, S.eyeHeight, S.eyeCorner, cl, GC9A01A_WHITE);
+      HE_drawCarvedEye(rightX, cy, S.eyeWidth, S.eyeHeight, S.eyeCorner, cr, GC9A01A_WHITE);
 
       if (now - S.phaseStart >= CARVE_EMO_TOTAL) {
         S.phase = decltype(S)::PH_RETURN_TO_NORMAL;
@@ -1840,21 +1783,17 @@ void drawCARVE_SESSION(unsigned long now) {
     } break;
 
     case decltype(S)::PH_DONE: {
-      S.wanderX = 0.0f;
-      S.wanderY = 0.0f;
+      S.wanderX = 0;
+      S.wanderY = 0;
       updateBlink(now);
       drawNormalEyesWithBlink(S.centerX, S.centerY);
-      // stay here; engine will time out via emotionDuration[] ceiling
+      // stay here; engine will time out via the EMOTIONS[] duration
     } break;
   }
 }
 // ------------------ /CARVE_SESSION ------------------
 
 //  -----------------SLEEPY----------------
-static inline uint16_t _ee_rgb565(uint8_t r, uint8_t g, uint8_t b){
-  return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-}
-static inline uint16_t _ee_gray565(uint8_t v){ return _ee_rgb565(v, v, v); }
 
 void drawSLEEPY(uint32_t now) {
   // Reset local state whenever SLEEPY starts
@@ -1863,32 +1802,32 @@ void drawSLEEPY(uint32_t now) {
   if (freshStart) lastStart = emotionStartTime;
 
   // ---- smooth vertical wobble (buttery, no jitter) ----
-  static float  eyeY    = 0.0f;
-  static float  phase   = 0.0f;
+  static HE_q16   eyeY  = 0;
+  static uint32_t phase = 0;                   // binary angle in the top 16 bits
   static uint32_t lastT = 0;
 
-  const float wobbleAmp  = 0.085f * eyeWidth;  // ~6 px if eyeWidth=70
-  const float wobbleFreq = 0.48f;              // Hz (~2.1s cycle)
-  const float wobbleEase = 0.08f;              // 0..1
+  const HE_q16   wobbleAmp  = HE_toQ16(0.085f) * eyeWidth;  // ~6 px if eyeWidth=70
+  const uint32_t wobbleStep = 2061584;         // per ms: 0.48 Hz (~2.1s cycle)
+  const HE_q16   wobbleEase = HE_toQ16(0.08f); // 0..1
 
   if (freshStart) {
-    eyeY  = (float)centerY;
-    phase = 0.0f;
+    eyeY  = centerY * HE_Q16_ONE;
+    phase = 0;
     lastT = now;
   }
 
-  float dt = (lastT == 0) ? 0.016f : (now - lastT) * 0.001f;
+  uint32_t dtMs = (lastT == 0) ? 16 : now - lastT;
   lastT = now;
 
-  const float omega  = 2.0f * PI * wobbleFreq;
-  const float target = (float)centerY + wobbleAmp * sinf(phase);
-  phase += omega * dt;
-  eyeY += (target - eyeY) * wobbleEase;
-  const int cy = (int)roundf(eyeY);
+  const HE_q16 target = centerY * HE_Q16_ONE + HE_mulQ16(wobbleAmp, HE_sinQ16(phase >> 16));
+  phase += wobbleStep * dtMs;
+  eyeY += HE_mulQ16(target - eyeY, wobbleEase);
+  const int cy = (eyeY + HE_Q16_HALF) >> 16;
 
   // ---- tiny "Z" particle pool ----
   struct ZZ {
-    float    x, y, vy;
+    int      x;
+    HE_q16   y, vy;
     uint16_t color;
     uint8_t  size;
     uint16_t birth, life;
@@ -1906,13 +1845,13 @@ void drawSLEEPY(uint32_t now) {
   if ((now - lastEmit) >= EMIT_MS) {
     lastEmit = now;
     for (auto &p : pool) if (!p.alive) {
-      p.x    = (float)(centerX + random(-6, 7));
-      p.y    = (float)(cy - (eyeHeight/2 + 5));
-      p.vy   = -0.35f - 0.10f * random(0, 25);
-      p.size = 1 + (uint8_t)random(0, 3);        // 1..3
+      p.x    = centerX + rng(BubuRng::SLEEPY).range(-6, 7);
+      p.y    = (cy - (eyeHeight/2 + 5)) * HE_Q16_ONE;
+      p.vy   = -HE_toQ16(0.35f) - HE_toQ16(0.10f) * rng(BubuRng::SLEEPY).range(0, 25);
+      p.size = 1 + (uint8_t)rng(BubuRng::SLEEPY).range(0, 3);        // 1..3
       p.birth= (uint16_t)(now & 0xFFFF);
-      p.life = 1400 + (uint16_t)random(0, 600);  // 1.4–2.0 s
-      p.color= _ee_gray565(220);
+      p.life = 1400 + (uint16_t)rng(BubuRng::SLEEPY).range(0, 600);  // 1.4–2.0 s
+      p.color= BubuColors::rgb565(220, 220, 220);
       p.alive= true;
       break;
     }
@@ -1920,7 +1859,7 @@ void drawSLEEPY(uint32_t now) {
 
   // ---- closed lids using your existing helper (handles spacing) ----
   // progress: 0=open … 1=fully closed
-  drawBlinkingEyes((float)centerX, (float)cy, 1.0f);
+  drawBlinkingEyes(centerX, cy, HE_Q16_ONE);
 
   // ---- draw the Zs ----
   canvas.setTextWrap(false);
@@ -1933,11 +1872,12 @@ void drawSLEEPY(uint32_t now) {
     p.y += p.vy;
 
     uint8_t v = (uint8_t)(220 - (220 * age) / p.life);
-    p.color = _ee_gray565(v);
+    p.color = BubuColors::rgb565(v, v, v);
 
     int idx = (int)(&p - &pool[0]);
-    int x = (int)(p.x + sinf(0.0025f * (float)now + 0.6f * idx) * 2.0f);
-    int y = (int)(p.y);
+    const uint16_t a = HE_angleMs(now, 2513) + HE_angleRad(0.6f) * idx;   // 0.0025 rad/ms
+    int x = p.x + 2 * HE_sinQ16(a) / HE_Q16_ONE;
+    int y = p.y >> 16;
 
     canvas.setTextSize(p.size);
     canvas.setTextColor(p.color);
@@ -1954,68 +1894,62 @@ static const uint16_t CRY_COL_EYE    = GC9A01A_WHITE;
 static const uint16_t CRY_COL_TEAR_L = 0xC618;  // light gray
 static const uint16_t CRY_COL_TEAR_R = 0xD67A;  // light gray alt
 
-// --- Timing (ms) — keep in sync with emotionDuration[CRY] ---
+// --- Timing (ms) — keep in sync with EMOTIONS[CRY].durationMs ---
 static const uint32_t CRY_PHASE_INTRO = 400;
 static const uint32_t CRY_PHASE_IN    = 1000;
 static const uint32_t CRY_PHASE_HOLD  = 5000;
 static const uint32_t CRY_PHASE_OUT   = 1000;
 
 // --- Wobble params ---
-static const float CRY_WOBBLE_A_MAX = 10.0f;  // px
-static const float CRY_WOBBLE_F     = 1.6f;   // Hz
+static const int      CRY_WOBBLE_A_MAX = 10;   // px
+static const uint32_t CRY_WOBBLE_MS    = 625;  // 1.6 Hz
 
 // --- Small helpers (prefixed to avoid conflicts) ---
-static inline float CRY_clamp01(float x){ return (x<0)?0:((x>1)?1:x); }
-static inline float CRY_easeInOut(float t){
-  t = CRY_clamp01(t);
-  return (t < 0.5f) ? (2.0f*t*t) : (-1.0f + (4.0f - 2.0f*t)*t);
-}
-static inline float CRY_lerpf(float a, float b, float t){ return a + (b - a)*t; }
-
 static inline void CRY_eyeBox(int cx, int cy, int w, int h, int r, uint16_t col){
   canvas.fillRoundRect(cx - w/2, cy - h/2, w, h, r, col);
 }
 
 // Tears (left eye = 4 drops)
-static void CRY_drawTearsLeftEye(int cx, int cy, float p){
+static void CRY_drawTearsLeftEye(int cx, int cy, HE_q16 p){
   const int baseY = cy + eyeHeight/2 - 6;
   const uint16_t c = CRY_COL_TEAR_L;
   int x1 = cx - 20;  int w1 = 10; int h1 = 34;
   int x2 = cx - 11;  int w2 =  8; int h2 = 26;
   int x3 = cx -  5;  int w3 = 12; int h3 = 44;
   int x4 = cx +  6;  int w4 =  8; int h4 = 24;
-  canvas.fillRoundRect(x1, baseY, w1, (int)(h1*p + 0.5f), 5, c);
-  canvas.fillRoundRect(x2, baseY, w2, (int)(h2*p + 0.5f), 4, c);
-  canvas.fillRoundRect(x3, baseY, w3, (int)(h3*p + 0.5f), 6, c);
-  canvas.fillRoundRect(x4, baseY, w4, (int)(h4*p + 0.5f), 4, c);
+  canvas.fillRoundRect(x1, baseY, w1, HE_scaleI(h1, p), 5, c);
+  canvas.fillRoundRect(x2, baseY, w2, HE_scaleI(h2, p), 4, c);
+  canvas.fillRoundRect(x3, baseY, w3, HE_scaleI(h3, p), 6, c);
+  canvas.fillRoundRect(x4, baseY, w4, HE_scaleI(h4, p), 4, c);
 }
 
 // Tears (right eye = 3 drops)
-static void CRY_drawTearsRightEye(int cx, int cy, float p){
+static void CRY_drawTearsRightEye(int cx, int cy, HE_q16 p){
   const int baseY = cy + eyeHeight/2 - 6;
   const uint16_t c = CRY_COL_TEAR_R;
   int x1 = cx - 10;  int w1 = 20; int h1 = 30;
   int x2 = cx -  2;  int w2 = 12; int h2 = 40;
   int x3 = cx + 10;  int w3 = 10; int h3 = 22;
-  canvas.fillRoundRect(x1, baseY, w1, (int)(h1*p + 0.5f), 5, c);
-  canvas.fillRoundRect(x2, baseY, w2, (int)(h2*p + 0.5f), 6, c);
-  canvas.fillRoundRect(x3, baseY, w3, (int)(h3*p + 0.5f), 4, c);
+  canvas.fillRoundRect(x1, baseY, w1, HE_scaleI(h1, p), 5, c);
+  canvas.fillRoundRect(x2, baseY, w2, HE_scaleI(h2, p), 6, c);
+  canvas.fillRoundRect(x3, baseY, w3, HE_scaleI(h3, p), 4, c);
 }
 
-static void CRY_drawFrame(float pTears, float wobbleA, float tSec){
+static void CRY_drawFrame(HE_q16 pTears, HE_q16 wobbleA, uint32_t ms){
 
 
   // Eyes & tears wobble together
-  const float phase = TWO_PI * CRY_WOBBLE_F * tSec;
-  const int wobX = (int)lroundf(wobbleA * sinf(phase));
-  const int wobY = (int)lroundf((wobbleA * 0.6f) * sinf(phase + 1.3f));
+  const uint16_t phase = HE_angleMs(ms, CRY_WOBBLE_MS);
+  const int wobX = (HE_mulQ16(wobbleA, HE_sinQ16(phase)) + HE_Q16_HALF) >> 16;
+  const int wobY = (HE_mulQ16(HE_mulQ16(wobbleA, HE_toQ16(0.6f)),
+                              HE_sinQ16(phase + HE_angleRad(1.3f))) + HE_Q16_HALF) >> 16;
 
   const int leftX  = centerX - eyeDistance + wobX;
   const int rightX = centerX + eyeDistance + wobX;
   const int cy     = centerY + wobY;
 
   // 1) tears behind
-  if (pTears > 0.0f){
+  if (pTears > 0){
     CRY_drawTearsLeftEye(leftX,  cy, pTears);
     CRY_drawTearsRightEye(rightX, cy, pTears);
   }
@@ -2035,83 +1969,44 @@ static void drawCRY(unsigned long now){
   const uint32_t TOTAL_MS = CRY_PHASE_INTRO + CRY_PHASE_IN + CRY_PHASE_HOLD + CRY_PHASE_OUT;
   if (e > TOTAL_MS) e = TOTAL_MS;
 
-  float pTears = 0.0f;   // 0..1
-  float wobA   = 0.0f;   // px
+  HE_q16 pTears = 0;   // 0..1
+  HE_q16 wobA   = 0;   // px
 
   if (e <= CRY_PHASE_INTRO){
-    pTears = 0.0f; wobA = 0.0f;
+    pTears = 0; wobA = 0;
   } else if (e <= CRY_PHASE_INTRO + CRY_PHASE_IN){
-    const float t = float(e - CRY_PHASE_INTRO) / float(CRY_PHASE_IN);
-    const float k = CRY_easeInOut(t);
+    const HE_q16 k = HE_easeInOutQ16(HE_ratioQ16(e - CRY_PHASE_INTRO, CRY_PHASE_IN));
     pTears = k;
-    wobA   = CRY_lerpf(0.0f, CRY_WOBBLE_A_MAX, k);
+    wobA   = k * CRY_WOBBLE_A_MAX;
   } else if (e <= CRY_PHASE_INTRO + CRY_PHASE_IN + CRY_PHASE_HOLD){
-    pTears = 1.0f;
-    wobA   = CRY_WOBBLE_A_MAX;
+    pTears = HE_Q16_ONE;
+    wobA   = CRY_WOBBLE_A_MAX * HE_Q16_ONE;
   } else {
     const uint32_t base = CRY_PHASE_INTRO + CRY_PHASE_IN + CRY_PHASE_HOLD;
-    const float t = float(e - base) / float(CRY_PHASE_OUT);
-    const float k = CRY_easeInOut(t);
-    pTears = 1.0f - k;
-    wobA   = CRY_lerpf(CRY_WOBBLE_A_MAX, 0.0f, k);
+    const HE_q16 k = HE_easeInOutQ16(HE_ratioQ16(e - base, CRY_PHASE_OUT));
+    pTears = HE_Q16_ONE - k;
+    wobA   = (HE_Q16_ONE - k) * CRY_WOBBLE_A_MAX;
   }
 
-  const float tSec = float(e) / 1000.0f;
-  CRY_drawFrame(pTears, wobA, tSec);
-
-  // Blit to screen (same as your other emotions)
-  tft.drawRGBBitmap(0, 0, canvas.getBuffer(), 240, 240);
+  CRY_drawFrame(pTears, wobA, e);
+  // (engine presents the frame)
 }
 
 // ===================================
 // Fireworks system
 // ===================================
 namespace FW {
-  static uint32_t fw_seed = 0xA5F0361Du;
-  static inline uint32_t fw_xrng(uint32_t &s) {
-    uint32_t x = s;
-    x ^= x << 13;
-    x ^= x >> 17;
-    x ^= x << 5;
-    s = x;
-    return x;
-  }
-  static inline uint16_t fw_hue2rgb565(uint8_t hue) {
-    uint8_t seg = hue >> 5;
-    uint8_t off = (hue & 31) << 3;
-    uint8_t r=0,g=0,b=0;
-    switch(seg){
-      case 0: r=255; g=off;  b=0;    break;
-      case 1: r=255-off; g=255; b=0; break;
-      case 2: r=0; g=255; b=off;     break;
-      case 3: r=0; g=255-off; b=255; break;
-      case 4: r=off; g=0; b=255;     break;
-      default:r=255; g=0; b=255-off; break;
-    }
-    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-  }
-  static inline uint16_t fw_dim565(uint16_t c, uint8_t factor){
-    uint8_t r5 = (c >> 11) & 0x1F;
-    uint8_t g6 = (c >> 5)  & 0x3F;
-    uint8_t b5 =  c        & 0x1F;
-    uint8_t r = (r5 << 3) | (r5 >> 2);
-    uint8_t g = (g6 << 2) | (g6 >> 4);
-    uint8_t b = (b5 << 3) | (b5 >> 2);
-    r = (uint8_t)(((uint16_t)r * factor) >> 8);
-    g = (uint8_t)(((uint16_t)g * factor) >> 8);
-    b = (uint8_t)(((uint16_t)b * factor) >> 8);
-    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-  }
+  static inline BubuRng::Stream &fwRng() { return rng(BubuRng::FIREWORKS); }
   struct Particle {
-    float  x, y;
-    float  vx, vy;
+    HE_q16 x, y;                 // px, Q16
+    HE_q16 vx, vy;
     uint16_t color;
     uint8_t life;
     bool   alive;
   };
   struct Burst {
     bool   active;
-    float  cx, cy;
+    int    cx, cy;
     uint16_t baseColor;
     uint8_t  count;
     uint8_t  life;
@@ -2119,9 +2014,9 @@ namespace FW {
   };
   static const uint8_t  MAX_BURSTS    = 8;
   static const uint8_t  P_PER_BURST   = 25;
-  static const float    SPEED_MIN     = 1.4f;
-  static const float    SPEED_MAX     = 3.2f;
-  static const float    GRAVITY       = 0.2f;
+  static const HE_q16   SPEED_MIN     = HE_toQ16(1.4f);
+  static const HE_q16   SPEED_MAX     = HE_toQ16(3.2f);
+  static const HE_q16   GRAVITY       = HE_toQ16(0.2f);
   static const uint8_t  GLOBAL_FADE   = 230;
   static const uint8_t  BURST_FADE    = 2;
   static const uint8_t  PARTICLE_FADE = 2;
@@ -2129,11 +2024,7 @@ namespace FW {
   Particle  particles[MAX_BURSTS][P_PER_BURST];
   
   static void fadeCanvas(uint8_t factor){
-    uint16_t *buf = (uint16_t*)canvas.getBuffer();
-    const int N = 240 * 240;
-    for(int i=0;i<N;i++){
-      buf[i] = fw_dim565(buf[i], factor);
-    }
+    canvas.dim(factor);                     // skips the black sky
   }
   static void spawnBurst(){
     uint8_t idx = 255;
@@ -2143,27 +2034,29 @@ namespace FW {
     if(idx == 255) return;
     Burst &b = bursts[idx];
     b.active    = true;
-    b.cx        = 20 + (fw_xrng(fw_seed) % 200);
-    b.cy        = 30 + (fw_xrng(fw_seed) % 160);
-    b.baseColor = fw_hue2rgb565((uint8_t)(fw_xrng(fw_seed) % 192));
+    b.cx        = 20 + fwRng().below(200);
+    b.cy        = 30 + fwRng().below(160);
+    b.baseColor = BubuColors::hue((uint8_t)fwRng().below(BubuColors::HUE_STEPS));
     b.count     = P_PER_BURST;
     b.life      = 255;
-    b.sparkle   = 32 + (fw_xrng(fw_seed) % 64);
+    b.sparkle   = 32 + fwRng().below(64);
     for(uint8_t p=0;p<P_PER_BURST;p++){
-      float angle = (2.0f * PI * p) / P_PER_BURST;
-      float spd   = SPEED_MIN + ((fw_xrng(fw_seed) % 1000) / 1000.0f) * (SPEED_MAX - SPEED_MIN);
+      uint16_t angle = (uint16_t)((65536UL * p) / P_PER_BURST);
+      HE_q16 spd   = SPEED_MIN + (HE_q16)fwRng().below(1000) * (SPEED_MAX - SPEED_MIN) / 1000;
       Particle &pt = particles[idx][p];
-      pt.x = b.cx;
-      pt.y = b.cy;
-      pt.vx = cosf(angle) * spd;
-      pt.vy = sinf(angle) * spd;
+      pt.x = b.cx * HE_Q16_ONE;
+      pt.y = b.cy * HE_Q16_ONE;
+      pt.vx = HE_mulQ16(HE_cosQ16(angle), spd);
+      pt.vy = HE_mulQ16(HE_sinQ16(angle), spd);
       pt.color = b.baseColor;
       pt.life  = 230;
       pt.alive = true;
     }
   }
+  static BubuCanvas::Sprite dots[MAX_BURSTS * P_PER_BURST];   // this frame's 2x2 particles
   static void stepAndDraw(){
     fadeCanvas(GLOBAL_FADE);
+    int nDots = 0;
     for(uint8_t i=0;i<MAX_BURSTS;i++){
       if(!bursts[i].active) continue;
       Burst &b = bursts[i];
@@ -2171,14 +2064,14 @@ namespace FW {
       for(uint8_t p=0;p<b.count;p++){
         Particle &pt = particles[i][p];
         if(!pt.alive) continue;
-        pt.vy += GRAVITY * 0.20f;
+        pt.vy += GRAVITY / 5;          // 0.20 of GRAVITY per step
         pt.x  += pt.vx;
         pt.y  += pt.vy;
         if(pt.life > PARTICLE_FADE) pt.life -= PARTICLE_FADE; else pt.life = 0;
         if(pt.life == 0) { pt.alive = false; continue; }
         anyAlive = true;
         uint16_t col = pt.color;
-        if((fw_xrng(fw_seed) & 255) < b.sparkle){
+        if(fwRng().byte() < b.sparkle){
           uint16_t r = ((col >> 11) & 0x1F);
           uint16_t g = ((col >> 5)  & 0x3F);
           uint16_t bl= ( col        & 0x1F);
@@ -2187,14 +2080,11 @@ namespace FW {
           bl= min<uint16_t>(31, bl+ 8);
           col = (r << 11) | (g << 5) | bl;
         }
-        col = fw_dim565(col, pt.life);
-        int16_t xi = (int16_t)pt.x;
-        int16_t yi = (int16_t)pt.y;
+        col = BubuCanvas::dim565(col, pt.life);
+        int16_t xi = (int16_t)(pt.x >> 16);
+        int16_t yi = (int16_t)(pt.y >> 16);
         if((uint16_t)xi < 240 && (uint16_t)yi < 240){
-          canvas.drawPixel(xi, yi, col);
-          if(xi+1 < 240) canvas.drawPixel(xi+1, yi, col);
-          if(yi+1 < 240) canvas.drawPixel(xi, yi+1, col);
-          if(xi+1 < 240 && yi+1 < 240) canvas.drawPixel(xi+1, yi+1, col);
+          dots[nDots++] = { xi, yi, col, 0 };
         }
       }
       if(b.life > BURST_FADE) b.life -= BURST_FADE; else b.life = 0;
@@ -2202,7 +2092,10 @@ namespace FW {
         b.active = false;
       }
     }
-    if((fw_xrng(fw_seed) & 255) < 28){
+    static BubuCanvas::SpriteMask dot;
+    if(!dot.runs) HE_spriteRect(dot, 2, 2);
+    canvas.stampBatch(&dot, dots, nDots);
+    if(fwRng().byte() < 28){
       spawnBurst();
     }
   }
@@ -2214,8 +2107,6 @@ namespace FW {
       bursts[i].life   = 0;
       bursts[i].sparkle= 0;
     }
-    fw_seed ^= (uint32_t)((uintptr_t)&canvas);
-    fw_seed ^= millis() * 747796405u;
   }
 } // namespace FW
 
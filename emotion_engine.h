@@ -2,15 +2,18 @@
 #include <SPI.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_GC9A01A.h>
+#include "bubu_canvas.h"
 
 // Pins (same as your master)
 #define TFT_CS   2
 #define TFT_DC   5
 #define TFT_RST  -1
+#define TFT_SCK  4
+#define TFT_MOSI 3
 
 // Public hardware objects (defined in emotion_engine.cpp)
 extern Adafruit_GC9A01A tft;
-extern GFXcanvas16 canvas;
+extern BubuCanvas canvas;
 extern unsigned long emotionStartTime;
 extern bool gPreserveBackground;
 
@@ -1,5 +1,7 @@
 // fortune_teller.cpp
 #include "fortune_teller.h"
+#include "present_engine.h"
+#include "bubu_rng.h"
 #include <U8g2_for_Adafruit_GFX.h>
 
 namespace FortuneTeller {
@@ -171,26 +173,56 @@ static WrappedLayout wrapText(const char* text, int areaW, int lineHeight) {
 }
 
 // ---- blitter (nearest, centered) ----
+// One address window for the whole panel: every destination row is built in
+// a line buffer (black border + source row expanded through an x-index table)
+// and streamed as a single write. Rows that map to the same source row reuse
+// the line as is.
+static uint16_t lineBuf[240];
+static uint8_t  xIndex[240];
+
 static void blitCanvasScaled(float scale) {
   if (scale < 1.0f) scale = 1.0f;
   if (scale > MAX_SCALE) scale = MAX_SCALE;
 
+  const int panelW = tft->width(), panelH = tft->height();
   int dstW = int(CANVAS_W * scale + 0.5f);
   int dstH = int(CANVAS_H * scale + 0.5f);
-  int dstX0 = (tft->width()  - dstW)/2;
-  int dstY0 = (tft->height() - dstH)/2;
-
-  uint16_t* buf = canvas.getBuffer();
-
-  for (int dy=0; dy<dstH; ++dy) {
-    int sy = int(dy / scale); if (sy >= CANVAS_H) sy = CANVAS_H - 1;
-    uint16_t* srcRow = buf + sy * CANVAS_W;
-    int ty = dstY0 + dy;
-    for (int dx=0; dx<dstW; ++dx) {
-      int sx = int(dx / scale); if (sx >= CANVAS_W) sx = CANVAS_W - 1;
-      tft->drawPixel(dstX0 + dx, ty, srcRow[sx]);
+  if (dstW > panelW) dstW = panelW;
+  if (dstH > panelH) dstH = panelH;
+  int dstX0 = (panelW - dstW)/2;
+  int dstY0 = (panelH - dstH)/2;
+
+  for (int dx=0; dx<dstW; ++dx) {
+    int sx = int(dx / scale); if (sx >= CANVAS_W) sx = CANVAS_W - 1;
+    xIndex[dx] = (uint8_t)sx;
+  }
+
+  const uint16_t* buf = canvas.getBuffer();
+  int lineSy = -2;                        // -1 = border line, >=0 = source row
+
+  tft->startWrite();
+  tft->setAddrWindow(0, 0, panelW, panelH);
+  for (int ty=0; ty<panelH; ++ty) {
+    const int dy = ty - dstY0;
+    int sy = -1;
+    if (dy >= 0 && dy < dstH) { sy = int(dy / scale); if (sy >= CANVAS_H) sy = CANVAS_H - 1; }
+    if (sy != lineSy) {
+      if (sy < 0) {
+        memset(lineBuf, 0, panelW * 2);
+      } else {
+        const uint16_t* srcRow = buf + sy * CANVAS_W;
+        if (lineSy < 0) {                 // borders only change after a black line
+          memset(lineBuf, 0, dstX0 * 2);
+          memset(lineBuf + dstX0 + dstW, 0, (panelW - dstX0 - dstW) * 2);
+        }
+        uint16_t* d = lineBuf + dstX0;
+        for (int dx=0; dx<dstW; ++dx) d[dx] = srcRow[xIndex[dx]];
+      }
+      lineSy = sy;
     }
+    tft->writePixels(lineBuf, panelW);
   }
+  tft->endWrite();
 }
 
 static void drawFortuneAutoFit(const char* text) {
@@ -226,8 +258,10 @@ static void drawFortuneAutoFit(const char* text) {
     u8g2.print(L.lines[i]);
   }
 
-  tft->fillScreen(GC9A01A_BLACK);
-  blitCanvasScaled(scale);
+  PresentEngine::beginDirect();
+  blitCanvasScaled(scale);                // border is part of the stream
+  PresentEngine::endDirect();
+  PresentEngine::invalidate();   // panel no longer matches the engine canvas
 }
 
 // ======= Public API =======
@@ -239,8 +273,6 @@ void setup(Adafruit_GC9A01A* tftRef) {
   u8g2.setFontMode(1);
   u8g2.setFontDirection(0);
   u8g2.setForegroundColor(GC9A01A_WHITE);
-  // Seed once (engine likely already seeds; harmless here)
-  randomSeed(esp_random());
 }
 
 void begin(uint32_t durationMs) {
@@ -250,7 +282,7 @@ void begin(uint32_t durationMs) {
   lastSwitch = startedAt;                 // ← ensures no immediate rotate in loop()
   active     = true;
 
-  currentIndex = random(fortuneCount);
+  currentIndex = BubuRng::stream(BubuRng::FORTUNE).below(fortuneCount);
   drawFortuneAutoFit(fortunes[currentIndex]);
 }
 
@@ -260,7 +292,7 @@ bool loop() {
   // Update the text every 5s inside the emotion window
   if (now - lastSwitch > 5000) {
     lastSwitch = now;
-    currentIndex = random(fortuneCount);
+    currentIndex = BubuRng::stream(BubuRng::FORTUNE).below(fortuneCount);
     drawFortuneAutoFit(fortunes[currentIndex]);
   }
   if (now - startedAt >= playFor) {
@@ -275,7 +307,7 @@ void end() {
 }
 
 void reseed() {
-  currentIndex = random(fortuneCount);
+  currentIndex = BubuRng::stream(BubuRng::FORTUNE).below(fortuneCount);
 }
 
 } // namespace FortuneTeller
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "frame_pacer.h"
+
+namespace FramePacer {
+
+// ======= Config =======
+static constexpr uint8_t  MAX_DROPS_IN_ROW = 2;       // still show 1 of 3 frames when overloaded
+static constexpr uint32_t FPS_WINDOW_US    = 1000000;
+
+// ======= State =======
+static uint32_t periodUs   = 1000000 / 30;
+static uint8_t  target     = 30;
+static uint32_t frameStart = 0;     // micros() when the current frame began
+static uint32_t deadline   = 0;     // micros() when the current frame should end
+static bool     started    = false;
+static uint8_t  dropsInRow = 0;
+static uint32_t dropped    = 0;
+static uint32_t workUs     = 0;
+
+static uint32_t winStart = 0;
+static uint16_t winPresents = 0;
+static float    measured = 0.0f;
+
+static void startFrame(uint32_t now) {
+  frameStart = now;
+  deadline = now + periodUs;
+  started = true;
+}
+
+void setTargetFps(uint8_t fps) {
+  if (fps == 0) fps = 1;
+  target = fps;
+  periodUs = 1000000UL / fps;
+  started = false;
+}
+
+uint8_t targetFps() { return target; }
+
+bool presentDue() {
+  const uint32_t now = micros();
+  if (!started) startFrame(now);
+  const bool late = (int32_t)(now - deadline) > 0;
+  if (late && dropsInRow < MAX_DROPS_IN_ROW) {
+    ++dropsInRow;
+    ++dropped;
+    return false;
+  }
+  dropsInRow = 0;
+  ++winPresents;
+  return true;
+}
+
+void endFrame() {
+  uint32_t now = micros();
+  if (!started) startFrame(now);
+  workUs = now - frameStart;
+
+  const int32_t left = (int32_t)(deadline - now);
+  if (left > 0) {
+    delay((uint32_t)left / 1000);      // yields to other tasks
+    const int32_t rest = (int32_t)(deadline - micros());
+    if (rest > 0) delayMicroseconds((uint32_t)rest);
+    deadline += periodUs;
+  } else if ((uint32_t)(-left) > periodUs) {
+    deadline = now + periodUs;         // hopelessly behind: resync, don't burst
+  } else {
+    deadline += periodUs;              // slightly late: keep the grid
+  }
+  frameStart = micros();
+
+  if (frameStart - winStart >= FPS_WINDOW_US) {
+    measured = winPresents * 1000000.0f / (float)(frameStart - winStart);
+    winStart = frameStart;
+    winPresents = 0;
+  }
+}
+
+float fps() { return measured; }
+uint32_t droppedPresents() { return dropped; }
+uint32_t lastWorkUs() { return workUs; }
+
+} // namespace FramePacer
@@ -0,0 +1,25 @@
+#pragma once
+#include <Arduino.h>
+
+// Fixed-timestep frame pacing.
+// Each frame: simulate/draw, ask presentDue(), present (or skip), endFrame().
+// endFrame() sleeps only for what is left of the frame period, so the rate
+// no longer depends on how long rendering and SPI took. A frame that ran past
+// its deadline skips its present (the canvas keeps the damage), so animation
+// time never slows down; the next on-time frame sends everything.
+namespace FramePacer {
+
+// ---- Setup ----
+void setTargetFps(uint8_t fps);    // default 30
+uint8_t targetFps();
+
+// ---- Per frame ----
+bool presentDue();   // false when this frame is late and its present should be dropped
+void endFrame();     // sleep out the rest of the period; starts the next frame
+
+// ---- Introspection ----
+float fps();                  // presents per second (last ~1 s)
+uint32_t droppedPresents();   // total presents skipped since boot
+uint32_t lastWorkUs();        // busy time of the last frame
+
+} // namespace FramePacer
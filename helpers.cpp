@@ -1,7 +1,13 @@
 #include "helpers.h"
+#include "bubu_colors.h"
+#include "bubu_rng.h"
+
+// integer division rounding down / up (any signs)
+static inline int HE_floorDiv(int a, int b) { int q = a / b; return (q * b != a && ((a < 0) != (b < 0))) ? q - 1 : q; }
+static inline int HE_ceilDiv(int a, int b)  { return -HE_floorDiv(-a, b); }
 
 void drawShape(int cx, int cy, int w, int h, int corner, uint8_t fill) {
-  uint16_t col = tft.color565(fill, fill, fill);
+  uint16_t col = BubuColors::rgb565(fill, fill, fill);
   canvas.fillRoundRect(cx - w/2, cy - h/2, w, h, corner, col);
 }
 // access globals defined in emotion_engine.cpp
@@ -13,13 +19,13 @@ extern int eyeWidth, eyeHeight, eyeCorner;
 // only moved here so emotion_engine.cpp stays focused on state/flow.
 
 // === NORMAL helper ===
-void drawBlinkingEyes(float cx, float cy, float progress) {
-  int leftX  = (int)(cx - eyeDistance);
-  int rightX = (int)(cx + eyeDistance);
+void drawBlinkingEyes(int cx, int cy, HE_q16 progress) {
+  int leftX  = cx - eyeDistance;
+  int rightX = cx + eyeDistance;
 
-  float currentH = eyeHeight * (1.0f - progress);  // 70 → 0 while blinking
+  int currentH = HE_scaleI(eyeHeight, HE_Q16_ONE - HE_clampQ16(progress));  // 70 → 0 while blinking
 
-  if (currentH > 0.0f) {
+  if (currentH > 0) {
     canvas.fillRoundRect(leftX  - eyeWidth/2,  cy - currentH/2, eyeWidth, currentH, eyeCorner, GC9A01A_WHITE);
     canvas.fillRoundRect(rightX - eyeWidth/2,  cy - currentH/2, eyeWidth, currentH, eyeCorner, GC9A01A_WHITE);
   } else {
@@ -39,22 +45,7 @@ void drawCircleEyes(int lx, int rx, int y, int r) {
 
 // === CONFUSE helpers ===
 void drawCircleWithOpacity(int x, int y, int r, uint16_t color, uint8_t alpha) {
-  for (int dy = -r; dy <= r; dy++) {
-    for (int dx = -r; dx <= r; dx++) {
-      if (dx * dx + dy * dy <= r * r) {
-        int px = x + dx, py = y + dy;
-        if (px >= 0 && px < 240 && py >= 0 && py < 240) {
-          uint16_t bg = canvas.getPixel(px, py);
-          uint8_t r1 = (color >> 11) << 3, g1 = ((color >> 5) & 0x3F) << 2, b1 = (color & 0x1F) << 3;
-          uint8_t r0 = (bg >> 11) << 3, g0 = ((bg >> 5) & 0x3F) << 2, b0 = (bg & 0x1F) << 3;
-          uint8_t rM = (r0 * (255 - alpha) + r1 * alpha) / 255;
-          uint8_t gM = (g0 * (255 - alpha) + g1 * alpha) / 255;
-          uint8_t bM = (b0 * (255 - alpha) + b1 * alpha) / 255;
-          canvas.drawPixel(px, py, tft.color565(rM, gM, bM));
-        }
-      }
-    }
-  }
+  canvas.blendCircle(x, y, r, color, alpha);   // one span per row, blended in place
 }
 
 void drawEyeCircle(int x, int y, uint16_t c) {
@@ -66,19 +57,33 @@ void drawEyeFlat(int x, int y, uint16_t c) {
 
 
 // === DRUNK helper ===
-void drawDrunkWhirlpool(int cx, int cy, int r, bool cw, float phase) {
-  int n = 70;
-  float maxA = TWO_PI * 2.5;
-  float stepA = maxA / n;
-  float stepR = float(r) / n;
-  for (int i = 0; i < n; i++) {
-    float t = stepA * i * (cw ? 1 : -1) + phase;
-    float rad = i * stepR;
-    int x = cx + cos(t) * rad;
-    int y = cy + sin(t) * rad;
-    uint8_t s = map(i, 0, n, 255, 80);
-    uint16_t color = tft.color565(s, 0, s);
-    canvas.fillCircle(x, y, 2, color);
+// Spiral of WHIRL_POINTS dots over 2.5 turns, fixed per radius: only the
+// rotation changes per frame. Dots are the 5x5 disc fillCircle(.., 2, ..)
+// draws, as three rects, bright magenta at the centre fading outwards.
+static const int WHIRL_POINTS = 70;
+static constexpr BubuColors::Table<WHIRL_POINTS> WHIRL_RAMP =
+    BubuColors::ramp<WHIRL_POINTS>(BubuColors::rgb565(255, 0, 255), BubuColors::rgb565(80, 0, 80));
+struct WhirlTable {
+  int      r = -1;
+  uint16_t ang[WHIRL_POINTS];     // binary angle along the spiral
+  int32_t  rad[WHIRL_POINTS];     // radius, Q8
+};
+static const int8_t WHIRL_DOT[3][4] = { {-1, -2, 3, 1}, {-2, -1, 5, 3}, {-1, 2, 3, 1} };  // dx, dy, w, h
+
+void drawDrunkWhirlpool(int cx, int cy, int r, bool cw, uint16_t phase) {
+  static WhirlTable wt;
+  if (wt.r != r) {
+    for (int i = 0; i < WHIRL_POINTS; i++) {
+      wt.ang[i] = (uint16_t)((uint32_t)i * 65536u * 5u / (2u * WHIRL_POINTS));
+      wt.rad[i] = (int32_t)i * r * 256 / WHIRL_POINTS;
+    }
+    wt.r = r;
+  }
+  for (int i = 0; i < WHIRL_POINTS; i++) {
+    uint16_t a = cw ? phase + wt.ang[i] : phase - wt.ang[i];
+    int x = cx + ((wt.rad[i] * HE_cos16(a)) >> 22);   // Q8 * Q14
+    int y = cy + ((wt.rad[i] * HE_sin16(a)) >> 22);
+    for (const int8_t *d : WHIRL_DOT) canvas.fillRect(x + d[0], y + d[1], d[2], d[3], WHIRL_RAMP[i]);
   }
 }
 // ===FURIOUS helper ===
@@ -96,9 +101,33 @@ void HE_drawBrowsAngled(int leftCx, int rightCx, int y, int extent, int baseEyeW
   const int l_in_x  = leftCx  + (baseEyeW / 2);
   const int r_out_x = rightCx + (baseEyeW / 2);
   const int r_in_x  = rightCx - (baseEyeW / 2);
-  for (int t = 0; t < 4; ++t) {
-    canvas.drawLine(l_out_x, y - extent + t, l_in_x, y + extent + t, color);
-    canvas.drawLine(r_out_x, y - extent + t, r_in_x, y + extent + t, color);
+  HE_drawThickLine(l_out_x, y - extent, l_in_x, y + extent, 4, color);
+  HE_drawThickLine(r_out_x, y - extent, r_in_x, y + extent, 4, color);
+}
+
+void HE_fillQuad(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3, uint16_t color) {
+  const int xs[4] = { x0, x1, x2, x3 }, ys[4] = { y0, y1, y2, y3 };
+  int top = ys[0], bot = ys[0];
+  for (int i = 1; i < 4; ++i) { if (ys[i] < top) top = ys[i]; if (ys[i] > bot) bot = ys[i]; }
+  if (top < 0) top = 0;
+  if (bot > canvas.height() - 1) bot = canvas.height() - 1;
+  for (int y = top; y <= bot; ++y) {
+    int a = INT16_MAX, b = INT16_MIN;
+    for (int i = 0; i < 4; ++i) {
+      const int ax = xs[i], ay = ys[i], bx = xs[(i + 1) & 3], by = ys[(i + 1) & 3];
+      if ((y < ay && y < by) || (y > ay && y > by)) continue;
+      if (ay == by) {                                  // horizontal edge on this row
+        a = min(a, min(ax, bx));
+        b = max(b, max(ax, bx));
+        continue;
+      }
+      // crossing x = ax + (bx - ax) * (y - ay) / (by - ay): inner bounds
+      const int num = (bx - ax) * (y - ay), den = by - ay;
+      const int lo = HE_ceilDiv(num, den) + ax, hi = HE_floorDiv(num, den) + ax;
+      if (lo < a) a = lo;
+      if (hi > b) b = hi;
+    }
+    if (a <= b) canvas.drawFastHLine(a, y, b - a + 1, color);
   }
 }
 uint16_t HE_colorLerp(uint16_t c1, uint16_t c2, float t) {
@@ -118,6 +147,98 @@ void HE_drawIdleEyes(int centerX, int centerY, int eyeDistance, int eyeW, int ey
   canvas.fillRoundRect(leftCx  - eyeW/2, centerY - eyeH/2, eyeW, eyeH, eyeR, color);
   canvas.fillRoundRect(rightCx - eyeW/2, centerY - eyeH/2, eyeW, eyeH, eyeR, color);
 }
+// Carved eye (ANGRY2, SMILE, CARVE_SESSION)
+
+void HE_drawCarvedEye(int cx, int cy, int w, int h, int r, const HE_EyeCarve &carve, uint16_t color) {
+  const int bx = cx - w/2, by = cy - h/2;
+  // diagonal endpoints (the edge line runs from x0 to x1 at the eye's top/bottom)
+  const int x0 = cx - w/2, x1 = cx + w/2, W = x1 - x0;
+  const bool top = carve.topL || carve.topR, bot = carve.botL || carve.botR;
+  const int tA = cy - h/2 + carve.topL, tD = carve.topR - carve.topL;
+  const int bA = cy + h/2 - carve.botL, bD = carve.botL - carve.botR;
+  const int ccy = cy + carve.circDy, cr = carve.circR;
+
+  int runY = 0, runH = 0, runA[2] = {0, 0}, runB[2] = {0, 0};
+  auto flush = [&]() {
+    for (int k = 0; k < 2; ++k)
+      if (runH && runA[k] < runB[k]) canvas.fillRect(runA[k], runY, runB[k] - runA[k], runH, color);
+    runH = 0;
+  };
+
+  for (int k = 0; k < h; ++k) {
+    const int y = by + k;
+    const int in = canvas.roundRectInset(w, h, r, k);
+    int a = bx + in, b = bx + w - in;                 // [a, b)
+    if (top) {                                        // keep below the line (exclusive)
+      const int R = (y - tA) * W;
+      if (tD > 0)      { int e = x0 + HE_ceilDiv(R, tD);  if (b > e) b = e; }
+      else if (tD < 0) { int s = x0 + HE_floorDiv(R, tD) + 1; if (a < s) a = s; }
+      else if (R <= 0) b = a;
+    }
+    if (bot) {                                        // keep above the line (exclusive)
+      const int R = (y - bA) * W;
+      if (bD < 0)      { int e = x0 + HE_ceilDiv(R, bD);  if (b > e) b = e; }
+      else if (bD > 0) { int s = x0 + HE_floorDiv(R, bD) + 1; if (a < s) a = s; }
+      else if (R >= 0) b = a;
+    }
+    int a2 = b, b2 = b;                               // second span right of the bite
+    const int dy = y - ccy;
+    if (cr > 0 && dy >= -cr && dy <= cr && a < b) {
+      int s = 0;
+      const int d = cr * cr - dy * dy;
+      while ((s + 1) * (s + 1) <= d) ++s;
+      const int c0 = cx - s, c1 = cx + s + 1;         // bitten [c0, c1)
+      a2 = (c1 > a) ? c1 : a;
+      if (b > c0) b = c0;
+    }
+    if (runH && runA[0] == a && runB[0] == b && runA[1] == a2 && runB[1] == b2) { ++runH; continue; }
+    flush();
+    runY = y; runH = 1;
+    runA[0] = a; runB[0] = b; runA[1] = a2; runB[1] = b2;
+  }
+  flush();
+}
+
+// ===== Sprite masks =====
+void HE_spriteRect(BubuCanvas::SpriteMask &m, int w, int h) {
+  m.runs = 0;
+  for (int y = 0; y < h; ++y) m.add(y, 0, w);
+}
+
+// Rows of a (2r+1)-square round rect with corner r: the same insets the
+// canvas uses for fillCircle, so stamped dots match drawn ones.
+void HE_spriteDisc(BubuCanvas::SpriteMask &m, int r) {
+  const int maxR = (BubuCanvas::SPRITE_RUNS - 1) / 2;
+  if (r > maxR) r = maxR;
+  if (r < 0) r = 0;
+  m.runs = 0;
+  for (int k = 0; k <= 2 * r; ++k) {
+    const int in = canvas.roundRectInset(2 * r + 1, 2 * r + 1, r, k);
+    m.add(k - r, -r + in, r + 1 - in);
+  }
+}
+
+// Union of the HLine diamond and VLine diamond the sparkle lambdas drew
+void HE_spriteSparkle(BubuCanvas::SpriteMask &m, int size) {
+  if (size > 7) size = 7;
+  if (size < 1) size = 1;
+  bool on[13][13] = {};                  // [dy + 6][dx + 6]
+  for (int i = 0; i < size; ++i) {
+    const int w = size - i;
+    for (int x = -w / 2; x < -w / 2 + w; ++x) on[6 - i][x + 6] = on[6 + i][x + 6] = true;
+    for (int y = -w / 2; y < -w / 2 + w; ++y) on[y + 6][6 - i] = on[y + 6][6 + i] = true;
+  }
+  m.runs = 0;
+  for (int y = 0; y < 13; ++y) {
+    for (int x = 0; x < 13; ) {
+      if (!on[y][x]) { ++x; continue; }
+      const int x0 = x;
+      while (x < 13 && on[y][x]) ++x;
+      m.add(y - 6, x0 - 6, x - 6);
+    }
+  }
+}
+
 // Basic ease-in-out parabola (0..1 -> 0..1)
 float EE_easeInOut(float t) {
   if (t < 0.0f) t = 0.0f;
@@ -129,8 +250,120 @@ float EE_easeInOut(float t) {
 // Eased + small noise (amp = ± amount, e.g. 0.02 = ±2%)
 float EE_jitteredEase(float progress, float amp) {
   float eased = EE_easeInOut(progress);
-  eased += (random(-1000, 1001) / 1000.0f) * amp;  // -1..1 scaled by amp
+  eased += (BubuRng::stream(BubuRng::EASE).range(-1000, 1001) / 1000.0f) * amp;  // -1..1 scaled by amp
   if (eased < 0) eased = 0;
   if (eased > 1) eased = 1;
   return eased;
-}
\ No newline at end of file
+}
+
+// ===== Fixed-point trig =====
+// Quarter wave, 256 steps, Q14
+static const int16_t HE_SIN_QUARTER[257] = {
+      0,   101,   201,   302,   402,   503,   603,   704,   804,   904,  1005,  1105,
+   1205,  1306,  1406,  1506,  1606,  1706,  1806,  1906,  2006,  2105,  2205,  2305,
+   2404,  2503,  2603,  2702,  2801,  2900,  2999,  3098,  3196,  3295,  3393,  3492,
+   3590,  3688,  3786,  3883,  3981,  4078,  4176,  4273,  4370,  4467,  4563,  4660,
+   4756,  4852,  4948,  5044,  5139,  5235,  5330,  5425,  5520,  5614,  5708,  5803,
+   5897,  5990,  6084,  6177,  6270,  6363,  6455,  6547,  6639,  6731,  6823,  6914,
+   7005,  7096,  7186,  7276,  7366,  7456,  7545,  7635,  7723,  7812,  7900,  7988,
+   8076,  8163,  8250,  8337,  8423,  8509,  8595,  8680,  8765,  8850,  8935,  9019,
+   9102,  9186,  9269,  9352,  9434,  9516,  9598,  9679,  9760,  9841,  9921, 10001,
+  10080, 10159, 10238, 10316, 10394, 10471, 10549, 10625, 10702, 10778, 10853, 10928,
+  11003, 11077, 11151, 11224, 11297, 11370, 11442, 11514, 11585, 11656, 11727, 11797,
+  11866, 11935, 12004, 12072, 12140, 12207, 12274, 12340, 12406, 12472, 12537, 12601,
+  12665, 12729, 12792, 12854, 12916, 12978, 13039, 13100, 13160, 13219, 13279, 13337,
+  13395, 13453, 13510, 13567, 13623, 13678, 13733, 13788, 13842, 13896, 13949, 14001,
+  14053, 14104, 14155, 14206, 14256, 14305, 14354, 14402, 14449, 14497, 14543, 14589,
+  14635, 14680, 14724, 14768, 14811, 14854, 14896, 14937, 14978, 15019, 15059, 15098,
+  15137, 15175, 15213, 15250, 15286, 15322, 15357, 15392, 15426, 15460, 15493, 15525,
+  15557, 15588, 15619, 15649, 15679, 15707, 15736, 15763, 15791, 15817, 15843, 15868,
+  15893, 15917, 15941, 15964, 15986, 16008, 16029, 16049, 16069, 16088, 16107, 16125,
+  16143, 16160, 16176, 16192, 16207, 16221, 16235, 16248, 16261, 16273, 16284, 16295,
+  16305, 16315, 16324, 16332, 16340, 16347, 16353, 16359, 16364, 16369, 16373, 16376,
+  16379, 16381, 16383, 16384, 16384
+};
+
+int16_t HE_sin16(uint16_t a) {
+#if HE_FLOAT_MATH
+  return (int16_t)lroundf(sinf(a * (6.2831853f / 65536.0f)) * 16384.0f);
+#else
+  uint16_t i = a >> 6;                 // 1024 steps per turn
+  uint16_t k = i & 255;
+  switch (i >> 8) {
+    case 0:  return  HE_SIN_QUARTER[k];
+    case 1:  return  HE_SIN_QUARTER[256 - k];
+    case 2:  return -HE_SIN_QUARTER[k];
+    default: return -HE_SIN_QUARTER[256 - k];
+  }
+#endif
+}
+
+// ===== Fixed-point math =====
+HE_q16 HE_ratioQ16(uint32_t num, uint32_t den) {
+  if (num >= den) return HE_Q16_ONE;
+  if (num < 0x10000) return (HE_q16)(((uint32_t)num << 16) / (uint32_t)den);
+  return (HE_q16)(((uint64_t)num << 16) / den);
+}
+
+HE_q16 HE_easeInOutQ16(HE_q16 t) {
+  t = HE_clampQ16(t);
+#if HE_FLOAT_MATH
+  return HE_toQ16(EE_easeInOut(HE_fromQ16(t)));
+#else
+  if (t < HE_Q16_HALF) return 2 * HE_mulQ16(t, t);
+  const HE_q16 u = HE_Q16_ONE - t;                     // mirrored half
+  return HE_Q16_ONE - 2 * HE_mulQ16(u, u);
+#endif
+}
+
+HE_q16 HE_smoothQ16(HE_q16 t) {
+  t = HE_clampQ16(t);
+#if HE_FLOAT_MATH
+  const float f = HE_fromQ16(t);
+  return HE_toQ16(f * f * (3.f - 2.f * f));
+#else
+  return HE_mulQ16(HE_mulQ16(t, t), 3 * HE_Q16_ONE - 2 * t);
+#endif
+}
+
+HE_q16 HE_easeOutQ16(HE_q16 t) {
+  const HE_q16 u = HE_Q16_ONE - HE_clampQ16(t);
+#if HE_FLOAT_MATH
+  const float f = HE_fromQ16(u);
+  return HE_toQ16(1.f - f * f);
+#else
+  return HE_Q16_ONE - HE_mulQ16(u, u);
+#endif
+}
+
+HE_q16 HE_easeInOutCubicQ16(HE_q16 t) {
+  t = HE_clampQ16(t);
+#if HE_FLOAT_MATH
+  return HE_toQ16(HE_easeInOutCubic(HE_fromQ16(t)));
+#else
+  const HE_q16 u = (t < HE_Q16_HALF) ? t : HE_Q16_ONE - t;
+  const HE_q16 c = 4 * HE_mulQ16(HE_mulQ16(u, u), u);
+  return (t < HE_Q16_HALF) ? c : HE_Q16_ONE - c;
+#endif
+}
+
+HE_q16 HE_jitteredEaseQ16(HE_q16 t, HE_q16 amp) {
+  HE_q16 eased = HE_easeInOutQ16(t);
+  eased += HE_mulQ16(BubuRng::stream(BubuRng::EASE).range(-HE_Q16_ONE, HE_Q16_ONE + 1), amp);   // -1..1 scaled by amp
+  return HE_clampQ16(eased);
+}
+
+uint16_t HE_colorLerpQ16(uint16_t c1, uint16_t c2, HE_q16 t) {
+  t = HE_clampQ16(t);
+#if HE_FLOAT_MATH
+  return HE_colorLerp(c1, c2, HE_fromQ16(t));
+#else
+  // same truncation as HE_colorLerp
+  int r1 = (c1 >> 11) & 0x1F, g1 = (c1 >> 5) & 0x3F, b1 = c1 & 0x1F;
+  int r2 = (c2 >> 11) & 0x1F, g2 = (c2 >> 5) & 0x3F, b2 = c2 & 0x1F;
+  int r = r1 + ((r2 - r1) * t) / HE_Q16_ONE;
+  int g = g1 + ((g2 - g1) * t) / HE_Q16_ONE;
+  int b = b1 + ((b2 - b1) * t) / HE_Q16_ONE;
+  return (r << 11) | (g << 5) | b;
+#endif
+}
@@ -1,15 +1,19 @@
 #pragma once
 #include <Adafruit_GFX.h>
 #include <Adafruit_GC9A01A.h>
+#include "bubu_canvas.h"
+
+// Q16 fixed point (65536 = 1.0); the helpers are under Fixed-point math below
+typedef int32_t HE_q16;
 
 // Use the same canvas/tft as engine (defined in emotion_engine.cpp)
 extern Adafruit_GC9A01A tft;
-extern GFXcanvas16 canvas;
+extern BubuCanvas canvas;
 
 // === Prototypes for helper drawing & small utilities moved out of the engine ===
 void drawShape(int cx, int cy, int w, int h, int corner, uint8_t fill);
-// from NORMAL
-void drawBlinkingEyes(float cx, float cy, float progress);
+// from NORMAL (progress: 0 = open, 1.0 = shut)
+void drawBlinkingEyes(int cx, int cy, HE_q16 progress);
 
 // tiny utility used by many states
 void drawBlinkLine(int x, int y, int w, int h, uint16_t c);
@@ -23,7 +27,7 @@ void drawEyeCircle(int x, int y, uint16_t c);
 void drawEyeFlat(int x, int y, uint16_t c);
 
 // from DRUNK
-void drawDrunkWhirlpool(int cx, int cy, int r, bool cw, float phase);
+void drawDrunkWhirlpool(int cx, int cy, int r, bool cw, uint16_t phase);   // phase: binary angle
 uint16_t HE_colorLerp(uint16_t c1, uint16_t c2, float t);
 
 // from ANGRY
@@ -40,20 +44,91 @@ void HE_drawEyeBox(int cx, int cy, int w, int h, int r = -1, uint16_t color = CO
 void HE_drawBrowsAngled(int leftCx, int rightCx, int y, int extent, int baseEyeW, uint16_t color = COL_FG);
 void HE_drawIdleEyes(int centerX, int centerY, int eyeDistance, int eyeW, int eyeH, int eyeR, uint16_t color = COL_FG);
 
+// Carved eye: rounded box minus a top and/or bottom diagonal (depth in px
+// at the left/right edge, measured from that edge) and a circular bite
+// centred circDy below the eye centre. Spans are computed per row and
+// filled once, so the background under the carve is left untouched.
+struct HE_EyeCarve {
+  int topL = 0, topR = 0;      // both 0: no top cut
+  int botL = 0, botR = 0;      // both 0: no bottom cut
+  int circR = 0, circDy = 0;   // circR 0: no bite
+};
+void HE_drawCarvedEye(int cx, int cy, int w, int h, int r, const HE_EyeCarve &carve, uint16_t color = COL_FG);
+
+// Convex quad filled by row spans; covers every pixel whose centre is on or
+// inside the outline (vertices are pixel centres, any winding).
+void HE_fillQuad(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3, uint16_t color = COL_FG);
+// Slanted stroke from (x0, y0) to (x1, y1), thick rows tall: the solid
+// version of `thick` stacked drawLine calls one row apart.
+inline void HE_drawThickLine(int x0, int y0, int x1, int y1, int thick, uint16_t color = COL_FG) {
+  HE_fillQuad(x0, y0, x1, y1, x1, y1 + thick - 1, x0, y0 + thick - 1, color);
+}
+
+// -------- Sprite masks (for canvas.stampBatch) --------
+// Built once per shape; the stamp point is the shape's centre.
+void HE_spriteRect(BubuCanvas::SpriteMask &m, int w, int h);     // top-left at the stamp point
+void HE_spriteDisc(BubuCanvas::SpriteMask &m, int r);            // = fillCircle(x, y, r)
+void HE_spriteSparkle(BubuCanvas::SpriteMask &m, int size);      // 4-point star, size 1..7
+
 // -------- Canvas helpers --------
 inline void HE_clearCanvas(uint16_t color = COL_BG) { canvas.fillScreen(color); }
 inline void HE_drawLine(int x0, int y0, int x1, int y1, uint16_t color = COL_FG) { canvas.drawLine(x0, y0, x1, y1, color); }
 inline int  HE_centerX() { return canvas.width() / 2; }
 inline int  HE_centerY() { return canvas.height() / 2; }
 
-// -------- Math / easing --------
+// -------- Math / easing (float reference) --------
 inline float HE_clamp(float v, float lo, float hi) { return (v < lo) ? lo : (v > hi) ? hi : v; }
 inline float HE_lerp(float a, float b, float t) { return a + (b - a) * t; }
 inline float HE_easeInOutCubic(float t) {
   t = HE_clamp(t, 0.0f, 1.0f);
-  return (t < 0.5f) ? 4.0f * t * t * t : 1.0f - powf(-2.0f * t + 2.0f, 3.0f) / 2.0f;
+  if (t < 0.5f) return 4.0f * t * t * t;
+  const float u = 2.0f - 2.0f * t;
+  return 1.0f - u * u * u / 2.0f;
 }
 
+// Fixed-point trig: binary angle (65536 = one turn), result Q14 (16384 = 1.0)
+int16_t HE_sin16(uint16_t a);
+inline int16_t HE_cos16(uint16_t a) { return HE_sin16((uint16_t)(a + 16384)); }
+
+// -------- Fixed-point math (Q16: 65536 = 1.0) --------
+// Per-frame animation math without soft-float calls. Building with
+// -DHE_FLOAT_MATH=1 routes the trig, easing and colour lerp through the
+// float versions above, as a reference to compare against.
+#ifndef HE_FLOAT_MATH
+#define HE_FLOAT_MATH 0
+#endif
+constexpr HE_q16 HE_Q16_ONE  = 65536;
+constexpr HE_q16 HE_Q16_HALF = 32768;
+constexpr HE_q16 HE_toQ16(float v) { return (HE_q16)(v * 65536.0f + (v < 0 ? -0.5f : 0.5f)); }   // for constants
+inline float     HE_fromQ16(HE_q16 v) { return v * (1.0f / 65536.0f); }
+inline HE_q16 HE_mulQ16(HE_q16 a, HE_q16 b) { return (HE_q16)(((int64_t)a * b) >> 16); }
+inline HE_q16 HE_clampQ16(HE_q16 v, HE_q16 lo = 0, HE_q16 hi = HE_Q16_ONE) { return (v < lo) ? lo : (v > hi) ? hi : v; }
+inline HE_q16 HE_lerpQ16(HE_q16 a, HE_q16 b, HE_q16 t) { return a + HE_mulQ16(b - a, t); }
+inline int    HE_roundQ16(HE_q16 v) { return (v + HE_Q16_HALF) >> 16; }   // nearest integer
+// a + (b - a) * t rounded to the nearest integer
+inline int HE_lerpI(int a, int b, HE_q16 t) { return a + (int)(((int64_t)(b - a) * t + HE_Q16_HALF) >> 16); }
+// n * t, rounded
+inline int HE_scaleI(int n, HE_q16 t) { return (int)(((int64_t)n * t + HE_Q16_HALF) >> 16); }
+// num / den clamped to 0..1, e.g. elapsed / duration
+HE_q16 HE_ratioQ16(uint32_t num, uint32_t den);
+
+// Easing on 0..1 (t clamped)
+HE_q16 HE_easeInOutQ16(HE_q16 t);        // parabola, = EE_easeInOut
+HE_q16 HE_smoothQ16(HE_q16 t);           // t*t*(3 - 2t)
+HE_q16 HE_easeOutQ16(HE_q16 t);          // 1 - (1 - t)^2
+HE_q16 HE_easeInOutCubicQ16(HE_q16 t);
+HE_q16 HE_jitteredEaseQ16(HE_q16 t, HE_q16 amp = HE_toQ16(0.02f));   // = EE_jitteredEase
+
+// Trig on a binary angle, result Q16
+inline HE_q16 HE_sinQ16(uint16_t a) { return (HE_q16)HE_sin16(a) * 4; }
+inline HE_q16 HE_cosQ16(uint16_t a) { return (HE_q16)HE_cos16(a) * 4; }
+// Angle after ms of a periodMs-long cycle (periodMs < 65536)
+inline uint16_t HE_angleMs(uint32_t ms, uint32_t periodMs) { return (uint16_t)(((ms % periodMs) << 16) / periodMs); }
+// Binary angle of a constant in radians
+constexpr uint16_t HE_angleRad(float rad) { return (uint16_t)(int32_t)(rad * (65536.0f / 6.2831853f) + 0.5f); }
+// 0 -> 1 -> 0 over one turn: (1 - cos) / 2
+inline HE_q16 HE_pulseQ16(uint16_t a) { return (HE_Q16_ONE - HE_cosQ16(a)) >> 1; }
+
 // Phase helpers: return 0..1 within a time slice (or -1 if outside)
 inline float HE_phase01(unsigned long now, unsigned long start, unsigned long dur) {
   if (now < start) return -1.0f;
@@ -67,6 +142,7 @@ inline int HE_jitter(unsigned long seedMs, unsigned stepMs, int magnitude) {
 }
 // These are implemented in helpers.cpp
 uint16_t HE_colorLerp(uint16_t c1, uint16_t c2, float t);
+uint16_t HE_colorLerpQ16(uint16_t c1, uint16_t c2, HE_q16 t);
 
 // Simple easing utilities (usable by any emotion)
 float EE_easeInOut(float t);
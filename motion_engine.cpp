@@ -168,66 +168,76 @@ static inline void onMTEEnd(unsigned long now) {
   idleSeenSince = 0;
 }
 
+static inline BubuEmotions::Anim animFor(RawCarState s) {
+  switch (s) {
+    case RawCarState::TURNING_LEFT:  return BubuEmotions::Anim::TURN_LEFT;
+    case RawCarState::TURNING_RIGHT: return BubuEmotions::Anim::TURN_RIGHT;
+    case RawCarState::ACCELERATING:  return BubuEmotions::Anim::SPEED_UP;
+    case RawCarState::BRAKING:       return BubuEmotions::Anim::BRAKES;
+    default:                         return BubuEmotions::Anim::NONE;
+  }
+}
+
 bool update() {
   if (!inited) return false;
 
-  // Read one sample
-  float ax, ay, az, gx_dps, gy_dps, gz_dps, tc;
-  if (!readMPU6500(detectedAddr, ax, ay, az, gx_dps, gy_dps, gz_dps, tc)) return false;
-
-  // Fixed mapping (X up, Y forward):
-  float fwd = ay;                                        // m/s^2
-  float yaw = INVERT_YAW ? -gx_dps : gx_dps;             // deg/s
-
-  RawCarState current = detectCarState(fwd, yaw);
-
-  // Optional debug
-  if (DEBUG_PRINT) {
-    static uint32_t dbgLast=0;
-    if (millis()-dbgLast > 200) {
-      Serial.printf("AY=%.2f m/s2  GX=%.1f dps  fwd=%.2f  yaw=%.1f  state=%d\n",
-                    ay, gx_dps, fwd, yaw, (int)current);
-      dbgLast = millis();
-    }
-  }
-
-  // ==== Playback gating (unchanged logic) ====
   unsigned long now = millis();
-  bool justPlayed = false;
 
-  if (readyForNext && !playingMTE &&
-      (now - lastMTEEndedMs) >= COOLDOWN_MS &&
-      current != RawCarState::IDLE_CAR) {
-
-    playingMTE = true;
-
-    switch (current) {
-      case RawCarState::TURNING_LEFT:  BubuEmotions::playTurnLeft(tft);  break;
-      case RawCarState::TURNING_RIGHT: BubuEmotions::playTurnRight(tft); break;
-      case RawCarState::ACCELERATING:  BubuEmotions::playSpeedUp(tft);   break;
-      case RawCarState::BRAKING:       BubuEmotions::playBrakes(tft);    break;
-      default: break;
+  // Read one sample (every frame, also while an MTE plays)
+  float ax, ay, az, gx_dps, gy_dps, gz_dps, tc;
+  if (readMPU6500(detectedAddr, ax, ay, az, gx_dps, gy_dps, gz_dps, tc)) {
+    // Fixed mapping (X up, Y forward):
+    float fwd = ay;                                        // m/s^2
+    float yaw = INVERT_YAW ? -gx_dps : gx_dps;             // deg/s
+
+    RawCarState current = detectCarState(fwd, yaw);
+
+    // Optional debug
+    if (DEBUG_PRINT) {
+      static uint32_t dbgLast=0;
+      if (millis()-dbgLast > 200) {
+        Serial.printf("AY=%.2f m/s2  GX=%.1f dps  fwd=%.2f  yaw=%.1f  state=%d\n",
+                      ay, gx_dps, fwd, yaw, (int)current);
+        dbgLast = millis();
+      }
     }
 
-    onMTEEnd(millis());
-    lastDetected = current;
-    bubuEngineRestartCycle();
-    justPlayed = true;
-
-  } else {
-    lastDetected = current;
-    // Rearm logic: once idle long enough, rearm
-    if (current == RawCarState::IDLE_CAR) {
-      if (idleSeenSince == 0) idleSeenSince = now;
-      if (!readyForNext && (now - idleSeenSince) >= IDLE_DWELL_MS) {
-        readyForNext = true;
+    // ==== Playback gating ====
+    const BubuEmotions::Anim want = animFor(current);
+    if (playingMTE) {
+      // A different event mid-animation: cut to it, or chain it once the
+      // current one is already heading home
+      if (want != BubuEmotions::Anim::NONE && want != BubuEmotions::playing() &&
+          current != lastDetected) {
+        if (BubuEmotions::homeward()) BubuEmotions::queue(want);
+        else                          BubuEmotions::start(want, now);
       }
+    } else if (readyForNext &&
+               (now - lastMTEEndedMs) >= COOLDOWN_MS &&
+               want != BubuEmotions::Anim::NONE) {
+      playingMTE = true;
+      BubuEmotions::start(want, now);
     } else {
-      idleSeenSince = 0; // moving again
+      // Rearm logic: once idle long enough, rearm
+      if (current == RawCarState::IDLE_CAR) {
+        if (idleSeenSince == 0) idleSeenSince = now;
+        if (!readyForNext && (now - idleSeenSince) >= IDLE_DWELL_MS) {
+          readyForNext = true;
+        }
+      } else {
+        idleSeenSince = 0; // moving again
+      }
     }
+    lastDetected = current;
   }
 
-  return justPlayed;
+  // ==== One MTE frame per engine frame ====
+  if (!playingMTE) return false;
+  if (BubuEmotions::step(now)) return true;
+
+  onMTEEnd(now);
+  bubuEngineRestartCycle();
+  return false;   // the engine draws this frame
 }
 
 // ================== PUBLIC TUNING API =================
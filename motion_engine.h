@@ -8,7 +8,7 @@ enum class CarState : uint8_t { IDLE_CAR = 0, ACCELERATING, BRAKING, TURNING_LEF
 
 // ---- Lifecycle ----
 void begin(uint8_t sda = 7, uint8_t scl = 6, uint8_t mpu_addr = 0x68);
-bool update();   // call once per frame; returns true iff an MTE just played
+bool update();   // call once per frame; true when it drew this frame (an MTE is playing)
 
 // ---- Tuning (optional) ----
 void setAccelThresholds(float speedUp_mps2, float brake_mps2_neg);
@@ -0,0 +1,396 @@
+#include "present_engine.h"
+#include "emotion_engine.h"   // TFT_* pins
+
+#if defined(ESP32)
+#include <driver/spi_master.h>
+#include <driver/gpio.h>
+#include <esp_heap_caps.h>
+#include <assert.h>
+#define PE_HAS_DMA 1
+#else
+#define PE_HAS_DMA 0
+#endif
+
+namespace PresentEngine {
+
+// ======= Config =======
+// A new address window costs ~11 bytes of commands plus CS/DC toggling;
+// merging a row into the current window is worth it while it wastes less.
+static constexpr int WINDOW_COST_PX = 24;
+static constexpr int PACK_ALIGN_PX  = 4;    // RGB444: 4 px = 6 bytes = 3 words
+
+static constexpr uint8_t CMD_COLMOD    = 0x3A;
+static constexpr uint8_t COLMOD_16BIT  = 0x05;
+static constexpr uint8_t COLMOD_12BIT  = 0x03;
+
+// ======= State =======
+static Adafruit_GC9A01A* tft = nullptr;
+static Mode curMode = Mode::BLOCKING;
+static bool fullNext = true;   // panel content unknown at boot
+static Format curFormat = Format::RGB565;
+static bool     hashing = true;
+static uint32_t rowHash[BubuCanvas::MAX_ROWS];   // what the panel shows, per row
+static uint32_t unchanged = 0;
+static bool     writing = false;                 // blocking: inside startWrite()
+
+// ================= RGB444 packing =================
+
+// n (even) RGB565 pixels -> n*3/2 bytes: R0G0 B0R1 G1B1
+static void pack444(const uint16_t* s, uint8_t* d, int n, bool swapped) {
+  for (int i = 0; i < n; i += 2, d += 3) {
+    uint16_t a = s[i], b = s[i + 1];
+    if (swapped) { a = (uint16_t)((a >> 8) | (a << 8)); b = (uint16_t)((b >> 8) | (b << 8)); }
+    d[0] = (uint8_t)(((a >> 8) & 0xF0) | ((a >> 7) & 0x0F));
+    d[1] = (uint8_t)(((a << 3) & 0xF0) | (b >> 12));
+    d[2] = (uint8_t)(((b >> 3) & 0xF0) | ((b >> 1) & 0x0F));
+  }
+}
+
+// ================= Blocking backend (Adafruit SPITFT) =================
+
+static void pushRectBlocking(BubuCanvas& c, int x0, int y0, int x1, int y1) {
+  const int w = x1 - x0, h = y1 - y0;
+  if (!writing) { tft->startWrite(); writing = true; }   // only once there is something to send
+  tft->setAddrWindow(x0, y0, w, h);
+  if (curFormat == Format::RGB444) {
+    static uint8_t line[240 * 3 / 2];
+    for (int y = y0; y < y1; ++y) {
+      pack444(c.rowPtr(y) + x0, line, w, c.panelOrder());
+      tft->writePixels((uint16_t*)line, (uint32_t)w * 3 / 4, true, true);   // raw bytes
+    }
+    return;
+  }
+  const bool big = c.panelOrder();      // already in wire order: no swap
+  if (w == c.width() && !c.isHalfRes()) {          // rows are contiguous
+    tft->writePixels((uint16_t*)c.rowPtr(y0), (uint32_t)w * h, true, big);
+  } else {
+    for (int y = y0; y < y1; ++y) tft->writePixels((uint16_t*)c.rowPtr(y) + x0, w, true, big);
+  }
+}
+
+// ================= Async backend (ESP-IDF spi_master + DMA) =================
+#if PE_HAS_DMA
+
+static constexpr int      DMA_SPI_HZ     = 40000000;
+static constexpr int      QUEUE_DEPTH    = 24;
+static constexpr uint32_t MAX_CHUNK_BYTES = 32000;   // C3: 18-bit SPI bit length
+
+static spi_device_handle_t dev = nullptr;
+static uint16_t* front = nullptr;      // DMA source; big-endian RGB565
+static uint32_t  frontHalfPx = 0;      // front is used as two halves; even, so both are word-aligned
+static uint32_t  frontUsed = 0;        // pixels staged in the current half
+static int       frontHalf = 0;
+static uint32_t  halfDoneAt[2] = { 0, 0 };   // transfers that must finish before a half is reused
+static spi_transaction_t trans[QUEUE_DEPTH];
+static int transHead = 0, inFlight = 0;
+static uint32_t queuedTotal = 0, doneTotal = 0;
+
+// DC level travels in t->user; set it right before each transaction starts
+static void IRAM_ATTR dcPreTransfer(spi_transaction_t* t) {
+  gpio_set_level((gpio_num_t)TFT_DC, (int)(intptr_t)t->user);
+}
+
+static void reclaimOne() {
+  spi_transaction_t* done = nullptr;
+  spi_device_get_trans_result(dev, &done, portMAX_DELAY);
+  --inFlight;
+  ++doneTotal;
+}
+
+static void queueBytes(bool dataMode, const void* data, size_t n) {
+  if (inFlight == QUEUE_DEPTH) reclaimOne();   // oldest slot is the next one
+  spi_transaction_t* t = &trans[transHead];
+  transHead = (transHead + 1) % QUEUE_DEPTH;
+  memset(t, 0, sizeof(*t));
+  t->length = n * 8;
+  t->user = (void*)(intptr_t)(dataMode ? 1 : 0);
+  if (n <= 4) {
+    t->flags = SPI_TRANS_USE_TXDATA;
+    memcpy(t->tx_data, data, n);
+  } else {
+    t->tx_buffer = data;
+  }
+  spi_device_queue_trans(dev, t, portMAX_DELAY);
+  ++inFlight;
+  ++queuedTotal;
+}
+
+static void queueWindow(int x, int y, int w, int h) {
+  const uint16_t x1 = x + w - 1, y1 = y + h - 1;
+  const uint8_t caset = 0x2A, raset = 0x2B, ramwr = 0x2C;
+  const uint8_t cols[4] = { (uint8_t)(x >> 8), (uint8_t)x, (uint8_t)(x1 >> 8), (uint8_t)x1 };
+  const uint8_t rows[4] = { (uint8_t)(y >> 8), (uint8_t)y, (uint8_t)(y1 >> 8), (uint8_t)y1 };
+  queueBytes(false, &caset, 1); queueBytes(true, cols, 4);
+  queueBytes(false, &raset, 1); queueBytes(true, rows, 4);
+  queueBytes(false, &ramwr, 1);
+}
+
+static bool dmaOpen() {
+  spi_bus_config_t bus = {};
+  bus.mosi_io_num   = TFT_MOSI;
+  bus.miso_io_num   = -1;
+  bus.sclk_io_num   = TFT_SCK;
+  bus.quadwp_io_num = -1;
+  bus.quadhd_io_num = -1;
+  bus.max_transfer_sz = MAX_CHUNK_BYTES;
+  if (spi_bus_initialize(SPI2_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK) return false;
+
+  spi_device_interface_config_t cfg = {};
+  cfg.clock_speed_hz = DMA_SPI_HZ;
+  cfg.mode           = 0;
+  cfg.spics_io_num   = TFT_CS;
+  cfg.queue_size     = QUEUE_DEPTH;
+  cfg.pre_cb         = dcPreTransfer;
+  if (spi_bus_add_device(SPI2_HOST, &cfg, &dev) != ESP_OK) {
+    spi_bus_free(SPI2_HOST);
+    return false;
+  }
+  return true;
+}
+
+static void dmaClose() {
+  wait();
+  spi_bus_remove_device(dev);
+  spi_bus_free(SPI2_HOST);
+  dev = nullptr;
+}
+
+// Give the bus back to SPIClass. spi_master owned TFT_CS (spics_io_num);
+// Adafruit_SPITFT drives CS through the GPIO output register, so the pin
+// has to be a deselected GPIO output again or the panel is never selected.
+static void spiClassBus() {
+  pinMode(TFT_CS, OUTPUT);
+  digitalWrite(TFT_CS, HIGH);
+  SPI.begin(TFT_SCK, -1, TFT_MOSI);
+}
+
+// Staging space for n pixels. The front buffer is a ring of two halves:
+// when the current half is full, switch to the other one once the
+// transfers reading it have completed. Slots are rounded up to whole
+// 32-bit words: spi_master copies unaligned tx buffers through a bounce
+// buffer, which would undo the zero-copy DMA.
+static uint16_t* stageAlloc(uint32_t n) {
+  n = (n + 1) & ~1u;
+  if (frontUsed + n > frontHalfPx) {
+    halfDoneAt[frontHalf] = queuedTotal;
+    frontHalf ^= 1;
+    while (doneTotal < halfDoneAt[frontHalf]) reclaimOne();
+    frontUsed = 0;
+  }
+  uint16_t* p = front + frontHalf * frontHalfPx + frontUsed;
+  assert(((uintptr_t)p & 3) == 0);
+  frontUsed += n;
+  return p;
+}
+
+// Copy one run into the front buffer (byte-swapped for the wire unless the
+// canvas is already in panel order) and queue it. Long runs are split so
+// each transfer fits one SPI transaction.
+static void pushRectAsync(BubuCanvas& c, int x0, int y0, int x1, int y1) {
+  const int w = x1 - x0;
+  const bool packed = (curFormat == Format::RGB444);
+  const int rowWords = packed ? w * 3 / 4 : w;   // 16-bit words per row on the wire
+  const uint32_t maxBytes = min<uint32_t>(MAX_CHUNK_BYTES, frontHalfPx * 2);
+  const int rowsPerChunk = max<int>(1, maxBytes / (rowWords * 2));
+
+  for (int cy = y0; cy < y1; cy += rowsPerChunk) {
+    const int h = min<int>(rowsPerChunk, y1 - cy);
+    uint16_t* dst = stageAlloc((uint32_t)rowWords * h);
+    uint16_t* d = dst;
+    for (int y = cy; y < cy + h; ++y, d += rowWords) {
+      const uint16_t* s = c.rowPtr(y) + x0;
+      if (packed)         { pack444(s, (uint8_t*)d, w, c.panelOrder()); continue; }
+      if (c.panelOrder()) { memcpy(d, s, (size_t)w * 2); continue; }
+      for (int n = 0; n < w; ++n) { uint16_t v = s[n]; d[n] = (uint16_t)((v >> 8) | (v << 8)); }
+    }
+    queueWindow(x0, cy, w, h);
+    queueBytes(true, dst, (size_t)rowWords * h * 2);
+  }
+}
+
+#endif // PE_HAS_DMA
+
+// ================= Public API =================
+
+void begin(Adafruit_GC9A01A* tftRef, Mode m, uint32_t stagingBytes) {
+  tft = tftRef;
+  fullNext = true;
+  curMode = Mode::BLOCKING;
+#if PE_HAS_DMA
+  if (m == Mode::ASYNC) {
+    if (stagingBytes == 0) stagingBytes = (uint32_t)tft->width() * tft->height() * 2;
+    frontHalfPx = ((stagingBytes / 4) + 1) & ~1u;   // each half a multiple of 4 bytes
+    frontUsed = 0;
+    frontHalf = 0;
+    front = (uint16_t*)heap_caps_aligned_alloc(4, (size_t)frontHalfPx * 4,
+                                               MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+    if (front) {
+      assert(((uintptr_t)front & 3) == 0);
+      SPI.end();                      // the DMA driver takes over the bus
+      if (dmaOpen()) {
+        curMode = Mode::ASYNC;
+      } else {
+        spiClassBus();
+        heap_caps_free(front);
+        front = nullptr;
+      }
+    }
+  }
+#else
+  (void)m; (void)stagingBytes;
+#endif
+}
+
+Mode mode() { return curMode; }
+
+static void sendColmod(uint8_t v) {
+#if PE_HAS_DMA
+  if (curMode == Mode::ASYNC) {
+    queueBytes(false, &CMD_COLMOD, 1);
+    queueBytes(true, &v, 1);
+    return;
+  }
+#endif
+  tft->sendCommand(CMD_COLMOD, &v, 1);
+}
+
+void setFormat(Format f) {
+  curFormat = f;
+  if (tft) sendColmod(f == Format::RGB444 ? COLMOD_12BIT : COLMOD_16BIT);
+}
+
+Format format() { return curFormat; }
+
+void setRowHashing(bool on) {
+  hashing = on;
+  fullNext = true;                    // stored hashes may be stale
+}
+
+uint32_t unchangedFrames() { return unchanged; }
+
+void wait() {
+#if PE_HAS_DMA
+  if (curMode == Mode::ASYNC) {
+    while (inFlight > 0) reclaimOne();
+  }
+#endif
+}
+
+void invalidate() { fullNext = true; }
+
+void beginDirect() {
+  if (curFormat == Format::RGB444) sendColmod(COLMOD_16BIT);
+#if PE_HAS_DMA
+  if (curMode == Mode::ASYNC) {
+    dmaClose();
+    spiClassBus();
+  }
+#endif
+}
+
+void endDirect() {
+#if PE_HAS_DMA
+  if (curMode == Mode::ASYNC) {
+    SPI.end();
+    if (!dmaOpen()) {                 // could not get the bus back: stay blocking
+      spiClassBus();
+      heap_caps_free(front);
+      front = nullptr;
+      curMode = Mode::BLOCKING;
+    }
+  }
+#endif
+  if (curFormat == Format::RGB444) sendColmod(COLMOD_12BIT);
+}
+
+typedef void (*PushRectFn)(BubuCanvas&, int, int, int, int);
+
+static inline bool damaged(BubuCanvas& c, int y, int16_t& a, int16_t& b) {
+  if (fullNext) { a = c.rowStart(y); b = c.rowEnd(y); return a < b; }
+  return c.dirtyRow(y, a, b);
+}
+
+// FNV-1a over the visible pixels of row y
+static uint32_t hashRow(BubuCanvas& c, int y) {
+  const uint16_t* p = c.rowPtr(y);
+  uint32_t h = 2166136261u;
+  for (int x = c.rowStart(y), xe = c.rowEnd(y); x < xe; ++x) h = (h ^ p[x]) * 16777619u;
+  return h;
+}
+
+// Damaged and actually different from what the panel shows. Call once per
+// row per present (after the row is rendered): it records the new hash.
+static bool rowSpan(BubuCanvas& c, int y, int16_t& a, int16_t& b) {
+  if (!damaged(c, y, a, b)) return false;
+  if (!hashing) return true;
+  const uint32_t h = hashRow(c, y);
+  if (!fullNext && h == rowHash[y]) return false;
+  rowHash[y] = h;
+  return true;
+}
+
+// Greedy run building over rows [top, bottom): grow the current window row
+// by row while the extra (clean) pixels it drags in stay below the cost of a
+// new window. Rows are clipped to the visible span, so a round canvas never
+// sends its corners.
+static void pushRows(BubuCanvas& c, PushRectFn pushRect, int top, int bottom) {
+  int runY0 = -1, runX0 = 0, runX1 = 0;
+  for (int y = top; y <= bottom; ++y) {
+    int16_t a = 0, b = 0;
+    const bool dirty = (y < bottom) && rowSpan(c, y, a, b);
+    if (curFormat == Format::RGB444 && dirty) {
+      a &= ~(PACK_ALIGN_PX - 1);
+      b = (b + PACK_ALIGN_PX - 1) & ~(PACK_ALIGN_PX - 1);
+    }
+    if (runY0 >= 0) {
+      if (dirty) {
+        const int nx0 = min<int>(runX0, a), nx1 = max<int>(runX1, b);
+        const int waste = (nx1 - nx0) - (b - a) + ((runX0 - nx0) + (nx1 - runX1)) * (y - runY0);
+        if (waste <= WINDOW_COST_PX) { runX0 = nx0; runX1 = nx1; continue; }
+      }
+      pushRect(c, runX0, runY0, runX1, y);
+      runY0 = -1;
+    }
+    if (dirty) { runY0 = y; runX0 = a; runX1 = b; }
+  }
+}
+
+void present(BubuCanvas& c) {
+  if (!tft) return;
+
+  PushRectFn pushRect = pushRectBlocking;
+#if PE_HAS_DMA
+  if (curMode == Mode::ASYNC) pushRect = pushRectAsync;
+  const uint32_t queuedBefore = queuedTotal;
+#endif
+
+  const int top    = fullNext ? 0 : c.dirtyTop();
+  const int bottom = fullNext ? c.height() : c.dirtyBottom();
+  if (c.isBanded()) {
+    // Rasterize a band, send it, move on. With ASYNC the band has been
+    // copied out by the time the next one overwrites it.
+    for (int y0 = top - top % BubuCanvas::BAND_ROWS; y0 < bottom; y0 += BubuCanvas::BAND_ROWS) {
+      const int y1 = min<int>(y0 + BubuCanvas::BAND_ROWS, bottom);
+      const int r0 = max<int>(y0, top);
+      int16_t a, b;
+      int y = r0;
+      while (y < y1 && !damaged(c, y, a, b)) ++y;
+      if (y == y1) continue;           // nothing to send in this band
+      c.rasterBand(y0, min<int>(y0 + BubuCanvas::BAND_ROWS, c.height()));
+      pushRows(c, pushRect, y, y1);
+    }
+  } else {
+    pushRows(c, pushRect, top, bottom);
+  }
+  fullNext = false;
+
+  bool sent = writing;
+  if (writing) { tft->endWrite(); writing = false; }
+#if PE_HAS_DMA
+  sent = sent || (queuedTotal != queuedBefore);
+#endif
+  if (!sent) ++unchanged;
+  c.endFrame();
+}
+
+} // namespace PresentEngine
@@ -0,0 +1,61 @@
+#pragma once
+#include <Arduino.h>
+#include <Adafruit_GC9A01A.h>
+#include "bubu_canvas.h"
+
+// Present step: moves the shared canvas to the GC9A01A.
+// Only rows/columns the canvas reports as damaged are sent, each run of
+// similar rows as one address window.
+//
+// ASYNC mode (ESP32): the damaged runs are copied into a second, DMA-capable
+// frame buffer and streamed by the SPI peripheral while the CPU goes on to
+// render the next frame (and MotionEngine reads the IMU). The canvas is the
+// back buffer, the DMA buffer the front buffer. The front buffer is a ring:
+// a smaller one (e.g. two bands for a banded canvas) only means present()
+// sometimes waits for the oldest transfers.
+//
+// A banded canvas is rasterized here, band by band, as each band is sent.
+//
+// RGB444 format: the panel is switched to 12-bit COLMOD and rows are packed
+// on the fly, 3 bytes per 2 pixels (25% fewer bytes on the wire). Windows
+// are widened to multiples of 4 pixels so every row is whole 16-bit words.
+//
+// Row hashing: every damaged row is hashed after rendering and compared with
+// the hash of what the panel last got; rows that came out identical are not
+// sent, and a frame with no changed row costs no SPI traffic at all. This
+// also trims blanket damage such as markAllDirty() after direct buffer writes.
+namespace PresentEngine {
+  enum class Mode : uint8_t { BLOCKING, ASYNC };
+  enum class Format : uint8_t { RGB565, RGB444 };
+
+  // Call once after tft.begin(). ASYNC falls back to BLOCKING when the
+  // platform has no DMA path or the front buffer cannot be allocated.
+  // stagingBytes sizes the ASYNC front buffer; 0 = one full frame.
+  void begin(Adafruit_GC9A01A* tftRef, Mode mode = Mode::BLOCKING, uint32_t stagingBytes = 0);
+  Mode mode();
+
+  // Wire pixel format (sends COLMOD). Direct tft drawing between
+  // beginDirect()/endDirect() always sees RGB565.
+  void setFormat(Format f);
+  Format format();
+
+  // Push the damaged part of the canvas and start a new damage frame.
+  // In ASYNC mode this returns as soon as the transfer is queued.
+  void present(BubuCanvas& c);
+
+  // Row-hash filtering (default on)
+  void setRowHashing(bool on);
+  uint32_t unchangedFrames();   // presents that found nothing to send
+
+  // Block until the last queued transfer has left the SPI peripheral
+  void wait();
+
+  // Something wrote to the panel behind our back (e.g. FortuneTeller):
+  // the next present() sends the whole frame.
+  void invalidate();
+
+  // Bracket direct tft drawing with these. In ASYNC mode the SPI bus
+  // belongs to the DMA driver and is handed back to SPIClass meanwhile.
+  void beginDirect();
+  void endDirect();
+}